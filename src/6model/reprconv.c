@@ -576,8 +576,12 @@ MVMObject * MVM_repr_box_int(MVMThreadContext *tc, MVMObject *type, MVMint64 val
 }
 
 MVMObject * MVM_repr_box_num(MVMThreadContext *tc, MVMObject *type, MVMnum64 val) {
-    MVMObject *res = MVM_repr_alloc_init(tc, type);
-    MVM_repr_set_num(tc, res, val);
+    MVMObject *res;
+    res = MVM_numcache_get(tc, type, val);
+    if (res == 0) {
+        res = MVM_repr_alloc_init(tc, type);
+        MVM_repr_set_num(tc, res, val);
+    }
     return res;
 }
 
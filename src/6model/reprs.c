@@ -240,6 +240,9 @@ void MVM_repr_initialize_registry(MVMThreadContext *tc) {
     register_core_repr(Decoder);
     register_core_repr(SpeshLog);
     register_core_repr(StaticFrameSpesh);
+    register_core_repr(StringBuilder);
+    register_core_repr(ConcHash);
+    register_core_repr(ConcArray);
 
     tc->instance->num_reprs = MVM_REPR_CORE_COUNT;
 }
@@ -44,6 +44,9 @@
 #include "6model/reprs/Decoder.h"
 #include "6model/reprs/MVMSpeshLog.h"
 #include "6model/reprs/MVMStaticFrameSpesh.h"
+#include "6model/reprs/StringBuilder.h"
+#include "6model/reprs/ConcHash.h"
+#include "6model/reprs/ConcArray.h"
 
 /* REPR related functions. */
 void MVM_repr_initialize_registry(MVMThreadContext *tc);
@@ -98,8 +101,11 @@ const MVMREPROps * MVM_repr_get_by_name(MVMThreadContext *tc, MVMString *name);
 #define MVM_REPR_ID_MVMCPPStruct            42
 #define MVM_REPR_ID_Decoder                 43
 #define MVM_REPR_ID_MVMStaticFrameSpesh     44
+#define MVM_REPR_ID_StringBuilder           45
+#define MVM_REPR_ID_ConcHash                46
+#define MVM_REPR_ID_ConcArray               47
 
-#define MVM_REPR_CORE_COUNT                 45
+#define MVM_REPR_CORE_COUNT                 48
 #define MVM_REPR_MAX_COUNT                  64
 
 /* Default attribute functions for a REPR that lacks them. */
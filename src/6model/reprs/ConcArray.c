@@ -0,0 +1,336 @@
+#include "moar.h"
+
+/* This representation's function pointer table. */
+static const MVMREPROps ConcArray_this_repr;
+
+MVM_STATIC_INLINE size_t slots_size(MVMuint64 alloc) {
+    return sizeof(MVMConcArraySlots) + (alloc - 1) * sizeof(MVMObject *);
+}
+
+/* Takes the lock, marking the thread blocked while waiting for it. The
+ * caller must root any objects it holds, and refetch the body afterwards. */
+static void lock_array(MVMThreadContext *tc, uv_mutex_t *lock) {
+    MVM_gc_mark_thread_blocked(tc);
+    uv_mutex_lock(lock);
+    MVM_gc_mark_thread_unblocked(tc);
+}
+
+/* Makes sure there are at least the needed number of slots. Must be called
+ * with the lock held. Nothing in here can trigger GC. */
+static void grow(MVMThreadContext *tc, MVMConcArrayBody *body, MVMuint64 needed) {
+    MVMConcArraySlots *old_slots = body->slots;
+    MVMuint64 old_alloc = old_slots ? old_slots->alloc : 0;
+    MVMConcArraySlots *new_slots;
+    MVMuint64 alloc, i;
+
+    if (needed <= old_alloc)
+        return;
+    alloc = old_alloc < MVM_CONC_ARRAY_MIN_SLOTS ? MVM_CONC_ARRAY_MIN_SLOTS : old_alloc * 2;
+    if (alloc < needed)
+        alloc = needed;
+    new_slots = MVM_fixed_size_alloc_zeroed(tc, tc->instance->fsa, slots_size(alloc));
+    new_slots->alloc = alloc;
+    for (i = 0; i < old_alloc; i++)
+        new_slots->values[i] = (MVMObject *)MVM_load(&old_slots->values[i]);
+    MVM_barrier();
+    MVM_store(&body->slots, new_slots);
+
+    if (old_slots) {
+        /* A push that stored to the old slots after we copied them, but
+         * before it could see the new ones, is picked up here. Binds hold
+         * the lock, so only pushes, which fill empty slots, can race us. */
+        for (i = 0; i < old_alloc; i++) {
+            MVMObject *pushed = (MVMObject *)MVM_load(&old_slots->values[i]);
+            if (pushed)
+                MVM_trycas(&new_slots->values[i], NULL, pushed);
+        }
+        MVM_fixed_size_free_at_safepoint(tc, tc->instance->fsa,
+            slots_size(old_alloc), old_slots);
+    }
+}
+
+static void init_lock(MVMThreadContext *tc, MVMConcArrayBody *body) {
+    int init_stat;
+    body->lock = MVM_malloc(sizeof(uv_mutex_t));
+    if ((init_stat = uv_mutex_init(body->lock)) < 0) {
+        MVM_free(body->lock);
+        body->lock = NULL;
+        MVM_exception_throw_adhoc(tc, "Failed to initialize mutex: %s",
+            uv_strerror(init_stat));
+    }
+}
+
+/* Creates a new type object of this representation, and associates it with
+ * the given HOW. */
+static MVMObject * type_object_for(MVMThreadContext *tc, MVMObject *HOW) {
+    MVMSTable *st = MVM_gc_allocate_stable(tc, &ConcArray_this_repr, HOW);
+
+    MVMROOT(tc, st, {
+        MVMObject *obj = MVM_gc_allocate_type_object(tc, st);
+        MVM_ASSIGN_REF(tc, &(st->header), st->WHAT, obj);
+        st->size = sizeof(MVMConcArray);
+    });
+
+    return st->WHAT;
+}
+
+/* Initializes a new instance. */
+static void initialize(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data) {
+    init_lock(tc, (MVMConcArrayBody *)data);
+}
+
+/* Copies the body of one object to another. The source may be being
+ * changed by other threads, in which case we copy what we see. */
+static void copy_to(MVMThreadContext *tc, MVMSTable *st, void *src, MVMObject *dest_root, void *dest) {
+    MVMConcArrayBody  *src_body  = (MVMConcArrayBody *)src;
+    MVMConcArrayBody  *dest_body = (MVMConcArrayBody *)dest;
+    MVMConcArraySlots *slots     = (MVMConcArraySlots *)MVM_load(&src_body->slots);
+    MVMuint64 elems = MVM_load(&src_body->elems);
+    MVMuint64 i;
+    init_lock(tc, dest_body);
+    if (slots && elems > slots->alloc)
+        elems = slots->alloc;
+    if (slots && elems) {
+        grow(tc, dest_body, elems);
+        for (i = 0; i < elems; i++) {
+            MVMObject *value = (MVMObject *)MVM_load(&slots->values[i]);
+            MVM_ASSIGN_REF(tc, &(dest_root->header), dest_body->slots->values[i], value);
+        }
+        dest_body->elems = elems;
+    }
+}
+
+/* Adds held objects to the GC worklist. */
+static void gc_mark(MVMThreadContext *tc, MVMSTable *st, void *data, MVMGCWorklist *worklist) {
+    MVMConcArrayBody  *body  = (MVMConcArrayBody *)data;
+    MVMConcArraySlots *slots = body->slots;
+    MVMuint64 i;
+    if (slots)
+        for (i = 0; i < slots->alloc; i++)
+            MVM_gc_worklist_add(tc, worklist, &slots->values[i]);
+}
+
+/* Called by the VM in order to free memory associated with this object. */
+static void gc_free(MVMThreadContext *tc, MVMObject *obj) {
+    MVMConcArray *arr = (MVMConcArray *)obj;
+    if (arr->body.slots) {
+        MVM_fixed_size_free(tc, tc->instance->fsa,
+            slots_size(arr->body.slots->alloc), arr->body.slots);
+        arr->body.slots = NULL;
+    }
+    if (arr->body.lock) {
+        uv_mutex_destroy(arr->body.lock);
+        MVM_free(arr->body.lock);
+        arr->body.lock = NULL;
+    }
+}
+
+static const MVMStorageSpec storage_spec = {
+    MVM_STORAGE_SPEC_REFERENCE, /* inlineable */
+    0,                          /* bits */
+    0,                          /* align */
+    MVM_STORAGE_SPEC_BP_NONE,   /* boxed_primitive */
+    0,                          /* can_box */
+    0,                          /* is_unsigned */
+};
+
+/* Gets the storage specification for this representation. */
+static const MVMStorageSpec * get_storage_spec(MVMThreadContext *tc, MVMSTable *st) {
+    return &storage_spec;
+}
+
+/* Compose the representation. */
+static void compose(MVMThreadContext *tc, MVMSTable *st, MVMObject *info) {
+    /* Nothing to do for this REPR. */
+}
+
+static void at_pos(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMint64 index, MVMRegister *value, MVMuint16 kind) {
+    MVMConcArrayBody  *body  = (MVMConcArrayBody *)data;
+    MVMint64           elems = (MVMint64)MVM_load(&body->elems);
+    MVMConcArraySlots *slots;
+
+    if (kind != MVM_reg_obj)
+        MVM_exception_throw_adhoc(tc,
+            "ConcArray representation does not support native type storage");
+
+    /* Handle negative indexes. */
+    if (index < 0) {
+        index += elems;
+        if (index < 0)
+            MVM_exception_throw_adhoc(tc, "ConcArray: Index out of bounds");
+    }
+
+    slots = (MVMConcArraySlots *)MVM_load(&body->slots);
+    if (index >= elems || !slots || (MVMuint64)index >= slots->alloc) {
+        value->o = tc->instance->VMNull;
+    }
+    else {
+        MVMObject *found = (MVMObject *)MVM_load(&slots->values[index]);
+        value->o = found ? found : tc->instance->VMNull;
+    }
+}
+
+static void bind_pos(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMint64 index, MVMRegister value, MVMuint16 kind) {
+    MVMConcArrayBody *body = (MVMConcArrayBody *)data;
+    uv_mutex_t *lock = body->lock;
+    MVMObject *to_bind = value.o;
+    AO_t elems;
+
+    if (kind != MVM_reg_obj)
+        MVM_exception_throw_adhoc(tc,
+            "ConcArray representation does not support native type storage");
+    if (to_bind == NULL)
+        MVM_exception_throw_adhoc(tc, "Cannot store a null value in a ConcArray");
+
+    /* Handle negative indexes. */
+    if (index < 0) {
+        index += MVM_load(&body->elems);
+        if (index < 0)
+            MVM_exception_throw_adhoc(tc, "ConcArray: Index out of bounds");
+    }
+
+    MVMROOT(tc, root, {
+    MVMROOT(tc, to_bind, {
+        lock_array(tc, lock);
+    });
+    });
+    body = (MVMConcArrayBody *)OBJECT_BODY(root);
+    grow(tc, body, index + 1);
+
+    /* Binding past the end extends the array; pushes may be racing us to
+     * do the same. */
+    do {
+        elems = MVM_load(&body->elems);
+    } while (elems <= (AO_t)index && !MVM_trycas(&body->elems, elems, index + 1));
+
+    MVM_gc_write_barrier(tc, &(root->header), (MVMCollectable *)to_bind);
+    MVM_store(&body->slots->values[index], to_bind);
+    uv_mutex_unlock(lock);
+}
+
+static void push(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMRegister value, MVMuint16 kind) {
+    MVMConcArrayBody  *body = (MVMConcArrayBody *)data;
+    MVMObject         *to_push = value.o;
+    MVMConcArraySlots *slots, *current;
+    AO_t index;
+
+    if (kind != MVM_reg_obj)
+        MVM_exception_throw_adhoc(tc,
+            "ConcArray representation does not support native type storage");
+    if (to_push == NULL)
+        MVM_exception_throw_adhoc(tc, "Cannot store a null value in a ConcArray");
+
+    /* Claim an index, and grow if there is no slot for it yet. */
+    index = MVM_incr(&body->elems);
+    slots = (MVMConcArraySlots *)MVM_load(&body->slots);
+    if (!slots || index >= slots->alloc) {
+        uv_mutex_t *lock = body->lock;
+        MVMROOT(tc, root, {
+        MVMROOT(tc, to_push, {
+            lock_array(tc, lock);
+        });
+        });
+        body = (MVMConcArrayBody *)OBJECT_BODY(root);
+        grow(tc, body, index + 1);
+        slots = body->slots;
+        uv_mutex_unlock(lock);
+    }
+
+    /* Store, then make sure the slots we stored to were not replaced by a
+     * grow that might have copied them before we got there. */
+    MVM_gc_write_barrier(tc, &(root->header), (MVMCollectable *)to_push);
+    while (1) {
+        MVM_store(&slots->values[index], to_push);
+        current = (MVMConcArraySlots *)MVM_load(&body->slots);
+        if (current == slots)
+            break;
+        slots = current;
+    }
+}
+
+static MVMuint64 elems(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data) {
+    MVMConcArrayBody *body = (MVMConcArrayBody *)data;
+    return MVM_load(&body->elems);
+}
+
+static void at_pos_multidim(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMint64 num_indices, MVMint64 *indices, MVMRegister *result, MVMuint16 kind) {
+    if (num_indices != 1)
+        MVM_exception_throw_adhoc(tc, "A dynamic array can only be indexed with a single dimension");
+    at_pos(tc, st, root, data, indices[0], result, kind);
+}
+
+static void bind_pos_multidim(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMint64 num_indices, MVMint64 *indices, MVMRegister value, MVMuint16 kind) {
+    if (num_indices != 1)
+        MVM_exception_throw_adhoc(tc, "A dynamic array can only be indexed with a single dimension");
+    bind_pos(tc, st, root, data, indices[0], value, kind);
+}
+
+static MVMStorageSpec get_elem_storage_spec(MVMThreadContext *tc, MVMSTable *st) {
+    MVMStorageSpec spec;
+    spec.inlineable      = MVM_STORAGE_SPEC_REFERENCE;
+    spec.boxed_primitive = MVM_STORAGE_SPEC_BP_NONE;
+    spec.can_box         = 0;
+    spec.bits            = 0;
+    spec.align           = 0;
+    spec.is_unsigned     = 0;
+    return spec;
+}
+
+/* Set the size of the STable. */
+static void deserialize_stable_size(MVMThreadContext *tc, MVMSTable *st, MVMSerializationReader *reader) {
+    st->size = sizeof(MVMConcArray);
+}
+
+static MVMuint64 unmanaged_size(MVMThreadContext *tc, MVMSTable *st, void *data) {
+    MVMConcArrayBody *body = (MVMConcArrayBody *)data;
+    return sizeof(uv_mutex_t) + (body->slots ? slots_size(body->slots->alloc) : 0);
+}
+
+/* Initializes the representation. */
+const MVMREPROps * MVMConcArray_initialize(MVMThreadContext *tc) {
+    return &ConcArray_this_repr;
+}
+
+static const MVMREPROps ConcArray_this_repr = {
+    type_object_for,
+    MVM_gc_allocate_object,
+    initialize,
+    copy_to,
+    MVM_REPR_DEFAULT_ATTR_FUNCS,
+    MVM_REPR_DEFAULT_BOX_FUNCS,
+    {
+        at_pos,
+        bind_pos,
+        MVM_REPR_DEFAULT_SET_ELEMS,
+        push,
+        MVM_REPR_DEFAULT_POP,
+        MVM_REPR_DEFAULT_UNSHIFT,
+        MVM_REPR_DEFAULT_SHIFT,
+        MVM_REPR_DEFAULT_SPLICE,
+        at_pos_multidim,
+        bind_pos_multidim,
+        MVM_REPR_DEFAULT_DIMENSIONS,
+        MVM_REPR_DEFAULT_SET_DIMENSIONS,
+        get_elem_storage_spec
+    },    /* pos_funcs */
+    MVM_REPR_DEFAULT_ASS_FUNCS,
+    elems,
+    get_storage_spec,
+    NULL, /* change_type */
+    NULL, /* serialize */
+    NULL, /* deserialize */
+    NULL, /* serialize_repr_data */
+    NULL, /* deserialize_repr_data */
+    deserialize_stable_size,
+    gc_mark,
+    gc_free,
+    NULL, /* gc_cleanup */
+    NULL, /* gc_mark_repr_data */
+    NULL, /* gc_free_repr_data */
+    compose,
+    NULL, /* spesh */
+    "ConcArray", /* name */
+    MVM_REPR_ID_ConcArray,
+    unmanaged_size,
+    NULL, /* describe_refs */
+};
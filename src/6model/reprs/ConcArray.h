@@ -0,0 +1,34 @@
+/* Representation of an array of objects that many threads may use at once.
+ * Reads and pushes take no locks: a push claims an index by incrementing
+ * elems, growing the slots first if need be, and then stores to it. Binds
+ * and growth take the lock. Growing copies the slots to a new array, then
+ * goes over them again once it is visible, to pick up any pushes that went
+ * to the old one in the meantime; the old array is freed at the next
+ * safepoint, since other threads may still be looking at it. Until a push
+ * has stored its value, reading its index gives VMNull. */
+
+/* The number of slots allocated for the first push. */
+#define MVM_CONC_ARRAY_MIN_SLOTS 8
+
+struct MVMConcArraySlots {
+    MVMuint64  alloc;
+    MVMObject *values[1];
+};
+
+struct MVMConcArrayBody {
+    MVMConcArraySlots *slots;
+
+    /* Number of elements, counting pushes that have yet to store. */
+    AO_t elems;
+
+    /* Held while binding or growing; not in the body, as it is sensitive to
+     * being moved. */
+    uv_mutex_t *lock;
+};
+struct MVMConcArray {
+    MVMObject common;
+    MVMConcArrayBody body;
+};
+
+/* Function for REPR setup. */
+const MVMREPROps * MVMConcArray_initialize(MVMThreadContext *tc);
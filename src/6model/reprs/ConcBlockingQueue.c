@@ -1,4 +1,5 @@
 #include "moar.h"
+#include <platform/threads.h>
 
 /* This representation's function pointer table. */
 static const MVMREPROps ConcBlockingQueue_this_repr;
@@ -17,6 +18,100 @@ static MVMObject * type_object_for(MVMThreadContext *tc, MVMObject *HOW) {
     return st->WHAT;
 }
 
+/* Marks a slot that a taking thread got to before the pushing thread that
+ * claimed it; only its address matters. */
+static char taken_marker;
+#define TAKEN ((MVMObject *)&taken_marker)
+
+static MVMConcBlockingQueueSegment * alloc_segment(MVMThreadContext *tc) {
+    return MVM_fixed_size_alloc_zeroed(tc, tc->instance->fsa,
+        sizeof(MVMConcBlockingQueueSegment));
+}
+
+/* Adds a value at the tail of the queue. The caller must already have
+ * counted it in elems. Nothing in here can trigger GC, so the body can not
+ * move from under us, and no segment we look at can be freed. */
+static void enqueue(MVMThreadContext *tc, MVMObject *root, MVMConcBlockingQueueBody *cbq, MVMObject *value) {
+    MVM_gc_write_barrier(tc, &(root->header), (MVMCollectable *)value);
+    while (1) {
+        MVMConcBlockingQueueSegment *tail = (MVMConcBlockingQueueSegment *)MVM_load(&cbq->tail);
+        AO_t idx = MVM_incr(&tail->enq_idx);
+        if (idx < MVM_CBQ_SEGMENT_SIZE) {
+            /* Fails if a taker already gave up on the slot. */
+            if (MVM_trycas(&tail->values[idx], NULL, value))
+                return;
+        }
+        else if (tail == (MVMConcBlockingQueueSegment *)MVM_load(&cbq->tail)) {
+            /* Segment full; add a new one holding the value, or help along
+             * whoever already did. */
+            MVMConcBlockingQueueSegment *next = (MVMConcBlockingQueueSegment *)MVM_load(&tail->next);
+            if (next == NULL) {
+                MVMConcBlockingQueueSegment *add = alloc_segment(tc);
+                add->values[0] = value;
+                add->enq_idx   = 1;
+                if (MVM_trycas(&tail->next, NULL, add)) {
+                    MVM_trycas(&cbq->tail, tail, add);
+                    return;
+                }
+                MVM_fixed_size_free(tc, tc->instance->fsa,
+                    sizeof(MVMConcBlockingQueueSegment), add);
+            }
+            else {
+                MVM_trycas(&cbq->tail, tail, next);
+            }
+        }
+    }
+}
+
+/* Takes the value at the head of the queue, or returns NULL if there is no
+ * value there yet. Like enqueue, this never triggers GC. */
+static MVMObject * dequeue(MVMThreadContext *tc, MVMConcBlockingQueueBody *cbq) {
+    while (1) {
+        MVMConcBlockingQueueSegment *head = (MVMConcBlockingQueueSegment *)MVM_load(&cbq->head);
+        AO_t idx;
+        if (MVM_load(&head->deq_idx) >= MVM_load(&head->enq_idx) && !MVM_load(&head->next))
+            return NULL;
+        idx = MVM_incr(&head->deq_idx);
+        if (idx < MVM_CBQ_SEGMENT_SIZE) {
+            /* If the pusher that claimed this slot has not stored to it yet,
+             * mark it taken so they go elsewhere, and look further on. */
+            MVMObject *value;
+            do {
+                value = (MVMObject *)MVM_load(&head->values[idx]);
+            } while (!MVM_trycas(&head->values[idx], value, TAKEN));
+            if (value) {
+                MVM_decr(&cbq->elems);
+                return value;
+            }
+        }
+        else {
+            /* Segment used up; move on to the next, if there is one. Other
+             * threads may still be looking at this one, so it can only be
+             * freed once they are all at a safepoint. */
+            MVMConcBlockingQueueSegment *next = (MVMConcBlockingQueueSegment *)MVM_load(&head->next);
+            if (next == NULL)
+                return NULL;
+            if (MVM_trycas(&cbq->head, head, next))
+                MVM_fixed_size_free_at_safepoint(tc, tc->instance->fsa,
+                    sizeof(MVMConcBlockingQueueSegment), head);
+        }
+    }
+}
+
+/* Wakes threads parked waiting for a value, if there are any. */
+static void wake_waiters(MVMThreadContext *tc, MVMConcBlockingQueueLocks *locks, MVMint64 all) {
+    if (MVM_load(&locks->waiters)) {
+        MVM_gc_mark_thread_blocked(tc);
+        uv_mutex_lock(&locks->park_lock);
+        MVM_gc_mark_thread_unblocked(tc);
+        if (all)
+            uv_cond_broadcast(&locks->park_cond);
+        else
+            uv_cond_signal(&locks->park_cond);
+        uv_mutex_unlock(&locks->park_lock);
+    }
+}
+
 /* Initializes a new instance. */
 static void initialize(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data) {
     MVMConcBlockingQueueBody *cbq = (MVMConcBlockingQueueBody *)data;
@@ -24,18 +119,15 @@ static void initialize(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, voi
     /* Initialize locks. */
     int init_stat;
     cbq->locks = MVM_calloc(1, sizeof(MVMConcBlockingQueueLocks));
-    if ((init_stat = uv_mutex_init(&cbq->locks->head_lock)) < 0)
-        MVM_exception_throw_adhoc(tc, "Failed to initialize mutex: %s",
-            uv_strerror(init_stat));
-    if ((init_stat = uv_mutex_init(&cbq->locks->tail_lock)) < 0)
+    if ((init_stat = uv_mutex_init(&cbq->locks->park_lock)) < 0)
         MVM_exception_throw_adhoc(tc, "Failed to initialize mutex: %s",
             uv_strerror(init_stat));
-    if ((init_stat = uv_cond_init(&cbq->locks->head_cond)) < 0)
+    if ((init_stat = uv_cond_init(&cbq->locks->park_cond)) < 0)
         MVM_exception_throw_adhoc(tc, "Failed to initialize condition variable: %s",
             uv_strerror(init_stat));
 
-    /* Head and tail point to a null node. */
-    cbq->tail = cbq->head = MVM_calloc(1, sizeof(MVMConcBlockingQueueNode));
+    /* Head and tail start out as the same, empty, segment. */
+    cbq->tail = cbq->head = alloc_segment(tc);
 }
 
 /* Copies the body of one object to another. */
@@ -48,9 +140,12 @@ static void gc_mark(MVMThreadContext *tc, MVMSTable *st, void *data, MVMGCWorkli
     /* At this point we know the world is stopped, and thus we can safely do a
      * traversal of the data structure without needing locks. */
     MVMConcBlockingQueueBody *cbq = (MVMConcBlockingQueueBody *)data;
-    MVMConcBlockingQueueNode *cur = cbq->head;
+    MVMConcBlockingQueueSegment *cur = cbq->head;
     while (cur) {
-        MVM_gc_worklist_add(tc, worklist, &cur->value);
+        MVMuint32 i;
+        for (i = 0; i < MVM_CBQ_SEGMENT_SIZE; i++)
+            if (cur->values[i] != TAKEN)
+                MVM_gc_worklist_add(tc, worklist, &cur->values[i]);
         cur = cur->next;
     }
 }
@@ -59,19 +154,19 @@ static void gc_mark(MVMThreadContext *tc, MVMSTable *st, void *data, MVMGCWorkli
 static void gc_free(MVMThreadContext *tc, MVMObject *obj) {
     MVMConcBlockingQueue *cbq = (MVMConcBlockingQueue *)obj;
 
-    /* First, free all the nodes. */
-    MVMConcBlockingQueueNode *cur = cbq->body.head;
+    /* First, free all the segments. */
+    MVMConcBlockingQueueSegment *cur = cbq->body.head;
     while (cur) {
-        MVMConcBlockingQueueNode *next = cur->next;
-        MVM_free(cur);
+        MVMConcBlockingQueueSegment *next = cur->next;
+        MVM_fixed_size_free(tc, tc->instance->fsa,
+            sizeof(MVMConcBlockingQueueSegment), cur);
         cur = next;
     }
     cbq->body.head = cbq->body.tail = NULL;
 
     /* Clean up locks. */
-    uv_mutex_destroy(&cbq->body.locks->head_lock);
-    uv_mutex_destroy(&cbq->body.locks->tail_lock);
-    uv_cond_destroy(&cbq->body.locks->head_cond);
+    uv_mutex_destroy(&cbq->body.locks->park_lock);
+    uv_cond_destroy(&cbq->body.locks->park_cond);
     MVM_free(cbq->body.locks);
     cbq->body.locks = NULL;
 }
@@ -97,6 +192,7 @@ static void compose(MVMThreadContext *tc, MVMSTable *st, MVMObject *info) {
 
 static void at_pos(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMint64 index, MVMRegister *value, MVMuint16 kind) {
     MVMConcBlockingQueueBody *cbq = (MVMConcBlockingQueueBody *)data;
+    MVMConcBlockingQueueSegment *cur;
 
     if (index != 0)
         MVM_exception_throw_adhoc(tc,
@@ -105,37 +201,32 @@ static void at_pos(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *d
         MVM_exception_throw_adhoc(tc,
             "Can only get objects from a concurrent blocking queue");
 
-    if (MVM_load(&cbq->elems) > 0) {
-        MVMConcBlockingQueueNode *peeked;
-        unsigned int interval_id;
-        interval_id = MVM_telemetry_interval_start(tc, "ConcBlockingQueue.at_pos");
-        MVMROOT(tc, root, {
-            MVM_gc_mark_thread_blocked(tc);
-            uv_mutex_lock(&cbq->locks->head_lock);
-            MVM_gc_mark_thread_unblocked(tc);
-            data = OBJECT_BODY(root);
-            cbq = (MVMConcBlockingQueueBody *)data;
-        });
-        peeked = cbq->head->next;
-        value->o = peeked ? peeked->value : tc->instance->VMNull;
-        uv_mutex_unlock(&cbq->locks->head_lock);
-        MVM_telemetry_interval_stop(tc, interval_id, "ConcBlockingQueue.at_pos");
-    }
-    else {
-        value->o = tc->instance->VMNull;
+    /* Look for the first value not yet taken. */
+    value->o = tc->instance->VMNull;
+    cur = (MVMConcBlockingQueueSegment *)MVM_load(&cbq->head);
+    while (cur) {
+        AO_t idx = MVM_load(&cur->deq_idx);
+        AO_t end = MVM_load(&cur->enq_idx);
+        if (end > MVM_CBQ_SEGMENT_SIZE)
+            end = MVM_CBQ_SEGMENT_SIZE;
+        for (; idx < end; idx++) {
+            MVMObject *peeked = (MVMObject *)MVM_load(&cur->values[idx]);
+            if (peeked && peeked != TAKEN) {
+                value->o = peeked;
+                return;
+            }
+        }
+        cur = (MVMConcBlockingQueueSegment *)MVM_load(&cur->next);
     }
 }
 
 static MVMuint64 elems(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data) {
     MVMConcBlockingQueueBody *cbq = (MVMConcBlockingQueueBody *)data;
-    return MVM_load(cbq->elems);
+    return MVM_load(&cbq->elems);
 }
 
 static void push(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMRegister value, MVMuint16 kind) {
     MVMConcBlockingQueueBody *cbq = (MVMConcBlockingQueueBody *)data;
-    MVMConcBlockingQueueNode *add;
-    AO_t orig_elems;
-    MVMObject *to_add = value.o;
     unsigned int interval_id;
 
     if (kind != MVM_reg_obj)
@@ -145,75 +236,59 @@ static void push(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *dat
         MVM_exception_throw_adhoc(tc,
             "Cannot store a null value in a concurrent blocking queue");
 
-    add = MVM_calloc(1, sizeof(MVMConcBlockingQueueNode));
-
     interval_id = MVM_telemetry_interval_start(tc, "ConcBlockingQueue.push");
-    MVMROOT(tc, root, {
-    MVMROOT(tc, to_add, {
-        MVM_gc_mark_thread_blocked(tc);
-        uv_mutex_lock(&cbq->locks->tail_lock);
-        MVM_gc_mark_thread_unblocked(tc);
-    });
-    });
-    data = OBJECT_BODY(root);
-    cbq = (MVMConcBlockingQueueBody *)data;
-    MVM_ASSIGN_REF(tc, &(root->header), add->value, to_add);
-    cbq->tail->next = add;
-    cbq->tail = add;
-    orig_elems = MVM_incr(&cbq->elems);
-    uv_mutex_unlock(&cbq->locks->tail_lock);
-
-    if (orig_elems == 0) {
-        MVMROOT(tc, root, {
-            MVM_gc_mark_thread_blocked(tc);
-            uv_mutex_lock(&cbq->locks->head_lock);
-            MVM_gc_mark_thread_unblocked(tc);
-        });
-        data = OBJECT_BODY(root);
-        cbq = (MVMConcBlockingQueueBody *)data;
-        uv_cond_signal(&cbq->locks->head_cond);
-        uv_mutex_unlock(&cbq->locks->head_lock);
-    }
+    MVM_incr(&cbq->elems);
+    enqueue(tc, root, cbq, value.o);
+    wake_waiters(tc, cbq->locks, 0);
     MVM_telemetry_interval_stop(tc, interval_id, "ConcBlockingQueue.push");
 }
 
 static void shift(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMRegister *value, MVMuint16 kind) {
     MVMConcBlockingQueueBody *cbq = (MVMConcBlockingQueueBody *)data;
-    MVMConcBlockingQueueNode *taken;
+    MVMConcBlockingQueueLocks *locks = cbq->locks;
+    MVMObject *taken = NULL;
     unsigned int interval_id;
+    int tries;
 
     if (kind != MVM_reg_obj)
         MVM_exception_throw_adhoc(tc, "Can only shift objects from a ConcBlockingQueue");
 
     interval_id = MVM_telemetry_interval_start(tc, "ConcBlockingQueue.shift");
-    MVMROOT(tc, root, {
-        MVM_gc_mark_thread_blocked(tc);
-        uv_mutex_lock(&cbq->locks->head_lock);
-        MVM_gc_mark_thread_unblocked(tc);
-        data = OBJECT_BODY(root);
-        cbq  = (MVMConcBlockingQueueBody *)data;
 
-        while (MVM_load(&cbq->elems) == 0) {
+    /* Try for a while before parking, as a value is often only moments
+     * away. None of this can trigger GC, so the body stays put. */
+    for (tries = 0; tries < MVM_CBQ_SPIN_TRIES; tries++) {
+        if ((taken = dequeue(tc, cbq)))
+            break;
+        if (tries >= MVM_CBQ_SPIN_TRIES - MVM_CBQ_YIELD_TRIES)
+            MVM_platform_thread_yield();
+    }
+
+    if (!taken) {
+        /* Park. We count ourselves as a waiter before trying again under
+         * the lock, so a pusher either sees us and signals, or pushed early
+         * enough for that attempt to find its value. */
+        MVMROOT(tc, root, {
+            MVM_gc_mark_thread_blocked(tc);
+            uv_mutex_lock(&locks->park_lock);
+            MVM_gc_mark_thread_unblocked(tc);
+            MVM_incr(&locks->waiters);
+            while (!(taken = dequeue(tc, (MVMConcBlockingQueueBody *)OBJECT_BODY(root)))) {
                 MVM_gc_mark_thread_blocked(tc);
-                uv_cond_wait(&cbq->locks->head_cond, &cbq->locks->head_lock);
+                uv_cond_wait(&locks->park_cond, &locks->park_lock);
                 MVM_gc_mark_thread_unblocked(tc);
-                data = OBJECT_BODY(root);
-                cbq  = (MVMConcBlockingQueueBody *)data;
-        }
-    });
-
-    taken = cbq->head->next;
-    MVM_free(cbq->head);
-    cbq->head = taken;
-    MVM_barrier();
-    value->o = taken->value;
-    taken->value = NULL;
-    MVM_barrier();
+            }
+            MVM_decr(&locks->waiters);
+            cbq = (MVMConcBlockingQueueBody *)OBJECT_BODY(root);
+        });
 
-    if (MVM_decr(&cbq->elems) > 1)
-        uv_cond_signal(&cbq->locks->head_cond);
+        /* Pass the baton on if there is more to be had. */
+        if (MVM_load(&cbq->elems) > 0 && MVM_load(&locks->waiters) > 0)
+            uv_cond_signal(&locks->park_cond);
+        uv_mutex_unlock(&locks->park_lock);
+    }
 
-    uv_mutex_unlock(&cbq->locks->head_lock);
+    value->o = taken;
     MVM_telemetry_interval_stop(tc, interval_id, "ConcBlockingQueue.shift");
 }
 
@@ -271,34 +346,75 @@ static const MVMREPROps ConcBlockingQueue_this_repr = {
     NULL, /* describe_refs */
 };
 
-/* Polls a queue for a value, returning NULL if none is available. */
+/* Polls a queue for a value, returning VMNull if none is available. */
 MVMObject * MVM_concblockingqueue_poll(MVMThreadContext *tc, MVMConcBlockingQueue *queue) {
-    MVMConcBlockingQueue *cbq = (MVMConcBlockingQueue *)queue;
-    MVMConcBlockingQueueNode *taken;
-    MVMObject *result = tc->instance->VMNull;
+    MVMObject *result;
     unsigned int interval_id;
 
     interval_id = MVM_telemetry_interval_start(tc, "ConcBlockingQueue.poll");
-    MVMROOT(tc, cbq, {
-        MVM_gc_mark_thread_blocked(tc);
-        uv_mutex_lock(&cbq->body.locks->head_lock);
-        MVM_gc_mark_thread_unblocked(tc);
+    result = dequeue(tc, &queue->body);
+    MVM_telemetry_interval_stop(tc, interval_id, "ConcBlockingQueue.poll");
+    return result ? result : tc->instance->VMNull;
+}
+
+/* Pushes all of the values in a list onto a queue, waking waiting threads
+ * once at the end rather than for each value. All of the values are checked
+ * before any is pushed, so that we do not throw with values in the queue
+ * that nobody was woken up for. */
+void MVM_concblockingqueue_push_batch(MVMThreadContext *tc, MVMConcBlockingQueue *queue, MVMObject *values) {
+    MVMint64 num_values = MVM_repr_elems(tc, values);
+    MVMint64 i;
+    unsigned int interval_id;
+
+    MVMROOT(tc, queue, {
+    MVMROOT(tc, values, {
+        for (i = 0; i < num_values; i++)
+            if (MVM_repr_at_pos_o(tc, values, i) == NULL)
+                MVM_exception_throw_adhoc(tc,
+                    "Cannot store a null value in a concurrent blocking queue");
+    });
     });
 
-    if (MVM_load(&cbq->body.elems) > 0) {
-        taken = cbq->body.head->next;
-        MVM_free(cbq->body.head);
-        cbq->body.head = taken;
-        MVM_barrier();
-        result = taken->value;
-        taken->value = NULL;
-        MVM_barrier();
-        if (MVM_decr(&cbq->body.elems) > 1)
-            uv_cond_signal(&cbq->body.locks->head_cond);
-    }
+    interval_id = MVM_telemetry_interval_start(tc, "ConcBlockingQueue.push_batch");
+    MVMROOT(tc, queue, {
+    MVMROOT(tc, values, {
+        for (i = 0; i < num_values; i++) {
+            /* Getting the value may allocate, but enqueueing does not. */
+            MVMObject *value = MVM_repr_at_pos_o(tc, values, i);
+            MVM_incr(&queue->body.elems);
+            enqueue(tc, (MVMObject *)queue, &queue->body, value);
+        }
+    });
+    });
+    if (num_values > 0)
+        wake_waiters(tc, queue->body.locks, num_values > 1);
+    MVM_telemetry_interval_stop(tc, interval_id, "ConcBlockingQueue.push_batch");
+}
 
-    uv_mutex_unlock(&cbq->body.locks->head_lock);
+/* Takes up to max values from a queue without blocking, pushing them onto
+ * the target list. Returns the number of values taken. */
+MVMint64 MVM_concblockingqueue_poll_batch(MVMThreadContext *tc, MVMConcBlockingQueue *queue, MVMObject *target, MVMint64 max) {
+    MVMint64 num_taken = 0;
+    unsigned int interval_id;
 
-    MVM_telemetry_interval_stop(tc, interval_id, "ConcBlockingQueue.poll");
-    return result;
+    if (!IS_CONCRETE(target))
+        MVM_exception_throw_adhoc(tc,
+            "Cannot poll a batch from a concurrent blocking queue into a type object");
+
+    interval_id = MVM_telemetry_interval_start(tc, "ConcBlockingQueue.poll_batch");
+    MVMROOT(tc, queue, {
+    MVMROOT(tc, target, {
+        while (num_taken < max) {
+            MVMObject *value = dequeue(tc, &queue->body);
+            if (!value)
+                break;
+            MVMROOT(tc, value, {
+                MVM_repr_push_o(tc, target, value);
+            });
+            num_taken++;
+        }
+    });
+    });
+    MVM_telemetry_interval_stop(tc, interval_id, "ConcBlockingQueue.poll_batch");
+    return num_taken;
 }
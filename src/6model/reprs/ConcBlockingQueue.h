@@ -1,25 +1,47 @@
-/* A single node in the concurrent blocking queue. */
-struct MVMConcBlockingQueueNode {
-    MVMObject                *value;
-    MVMConcBlockingQueueNode *next;
+/* The number of values held by each segment of a concurrent blocking queue. */
+#define MVM_CBQ_SEGMENT_SIZE 64
+
+/* How many times a thread taking from an empty queue retries, and how many
+ * of those retries yield the CPU, before it parks on the condition variable.
+ * Producers are often only a moment behind, so this saves most of the cost
+ * of sleeping and waking under load. */
+#define MVM_CBQ_SPIN_TRIES  64
+#define MVM_CBQ_YIELD_TRIES 8
+
+/* A segment of the concurrent blocking queue. Pushing threads claim a slot
+ * by incrementing enq_idx and then store into it; taking threads claim one
+ * by incrementing deq_idx and then swap the value out. A slot a taker gets
+ * to first is marked taken, and the pusher that claimed it tries again.
+ * Once every slot has been taken, the segment is unlinked and freed at the
+ * next safepoint, since other threads may still be looking at it. */
+struct MVMConcBlockingQueueSegment {
+    MVMConcBlockingQueueSegment *next;
+    AO_t                         enq_idx;
+    AO_t                         deq_idx;
+    MVMObject                   *values[MVM_CBQ_SEGMENT_SIZE];
 };
 
-/* Memory used for mutexes and cond vars; these can't live in the object body
- * directly as they are sensitive to being moved, but putting them together in
- * a single struct means we can malloc a single bit of memory to hold them. */
+/* Memory used for the mutex and cond var that threads park on once they
+ * have given up spinning; these can't live in the object body directly as
+ * they are sensitive to being moved, but putting them together in a single
+ * struct means we can malloc a single bit of memory to hold them. */
 struct MVMConcBlockingQueueLocks {
-    uv_mutex_t  head_lock;
-    uv_mutex_t  tail_lock;
-    uv_cond_t   head_cond;
+    uv_mutex_t  park_lock;
+    uv_cond_t   park_cond;
+
+    /* Number of threads parked or about to park; pushers only take the lock
+     * to wake them when this is non-zero. */
+    AO_t        waiters;
 };
 
 /* Representation used for concurrent blocking queue. */
 struct MVMConcBlockingQueueBody {
-    /* Head and tail of the queue. */
-    MVMConcBlockingQueueNode *head;
-    MVMConcBlockingQueueNode *tail;
+    /* Segments holding the head and tail of the queue. */
+    MVMConcBlockingQueueSegment *head;
+    MVMConcBlockingQueueSegment *tail;
 
-    /* Number of elements currently in the queue. */
+    /* Number of elements currently in the queue. Pushes count an element
+     * before it is visible, so this may briefly run ahead. */
     AO_t elems;
 
     /* Locks and condition variables storage. */
@@ -35,3 +57,5 @@ const MVMREPROps * MVMConcBlockingQueue_initialize(MVMThreadContext *tc);
 
 /* Operations on concurrent blocking queues. */
 MVMObject * MVM_concblockingqueue_poll(MVMThreadContext *tc, MVMConcBlockingQueue *queue);
+void MVM_concblockingqueue_push_batch(MVMThreadContext *tc, MVMConcBlockingQueue *queue, MVMObject *values);
+MVMint64 MVM_concblockingqueue_poll_batch(MVMThreadContext *tc, MVMConcBlockingQueue *queue, MVMObject *target, MVMint64 max);
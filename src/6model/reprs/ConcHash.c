@@ -0,0 +1,464 @@
+#include "moar.h"
+
+/* This representation's function pointer table. */
+static const MVMREPROps ConcHash_this_repr;
+
+MVM_STATIC_INLINE MVMString * get_string_key(MVMThreadContext *tc, MVMObject *key) {
+    if (!key || REPR(key)->ID != MVM_REPR_ID_MVMString || !IS_CONCRETE(key))
+        MVM_exception_throw_adhoc(tc, "ConcHash representation requires MVMString keys");
+    return (MVMString *)key;
+}
+
+MVM_STATIC_INLINE MVMuint32 hash_key(MVMThreadContext *tc, MVMString *key) {
+    if (!key->body.cached_hash_code)
+        MVM_string_compute_hash_code(tc, key);
+    return (MVMuint32)key->body.cached_hash_code;
+}
+
+MVM_STATIC_INLINE size_t bucket_size(MVMuint32 num_entries) {
+    return sizeof(MVMConcHashBucket) + (num_entries - 1) * sizeof(MVMConcHashEntry);
+}
+
+MVM_STATIC_INLINE size_t table_size(MVMuint32 num_buckets) {
+    return sizeof(MVMConcHashTable) + (num_buckets - 1) * sizeof(MVMConcHashBucket *);
+}
+
+static MVMConcHashTable * alloc_table(MVMThreadContext *tc, MVMuint32 num_buckets) {
+    MVMConcHashTable *table = MVM_fixed_size_alloc_zeroed(tc, tc->instance->fsa,
+        table_size(num_buckets));
+    table->num_buckets = num_buckets;
+    return table;
+}
+
+/* Looks for the entry for a key in a table. Takes no locks; since nothing in
+ * here can trigger GC, the buckets we look at can not be freed under us. */
+static MVMConcHashEntry * find_entry(MVMThreadContext *tc, MVMConcHashTable *table,
+        MVMString *key, MVMuint32 hash) {
+    MVMConcHashBucket *bucket = (MVMConcHashBucket *)MVM_load(
+        &table->buckets[hash & (table->num_buckets - 1)]);
+    if (bucket) {
+        MVMuint32 i;
+        for (i = 0; i < bucket->num_entries; i++) {
+            MVMConcHashEntry *entry = &bucket->entries[i];
+            if (entry->hash == hash && (entry->key == key || MVM_string_equal(tc, entry->key, key)))
+                return entry;
+        }
+    }
+    return NULL;
+}
+
+/* Sets up the table and locks of a new hash. */
+static void init_body(MVMThreadContext *tc, MVMConcHashBody *body) {
+    MVMuint32 i;
+    int init_stat;
+    body->locks = MVM_calloc(1, sizeof(MVMConcHashLocks));
+    for (i = 0; i < MVM_CONC_HASH_STRIPES; i++)
+        if ((init_stat = uv_mutex_init(&body->locks->stripes[i])) < 0)
+            MVM_exception_throw_adhoc(tc, "Failed to initialize mutex: %s",
+                uv_strerror(init_stat));
+    body->table = alloc_table(tc, MVM_CONC_HASH_INITIAL_BUCKETS);
+}
+
+/* Takes a stripe lock, marking the thread blocked while waiting for it. The
+ * caller must root any objects it holds, and refetch the body afterwards. */
+static void lock_stripe(MVMThreadContext *tc, uv_mutex_t *lock) {
+    MVM_gc_mark_thread_blocked(tc);
+    uv_mutex_lock(lock);
+    MVM_gc_mark_thread_unblocked(tc);
+}
+
+/* Makes the bucket for a key hold a new value, adding an entry if there is
+ * none. Must be called with the key's stripe lock held. */
+static void store_value(MVMThreadContext *tc, MVMObject *root, MVMConcHashBody *body,
+        MVMString *key, MVMuint32 hash, MVMObject *value) {
+    MVMConcHashTable  *table  = body->table;
+    MVMuint32          index  = hash & (table->num_buckets - 1);
+    MVMConcHashBucket *bucket = table->buckets[index];
+    MVMConcHashEntry  *entry  = find_entry(tc, table, key, hash);
+    MVM_gc_write_barrier(tc, &(root->header), (MVMCollectable *)value);
+    if (entry) {
+        MVM_store(&entry->value, value);
+    }
+    else {
+        MVMuint32 num_entries = bucket ? bucket->num_entries : 0;
+        MVMConcHashBucket *new_bucket = MVM_fixed_size_alloc(tc, tc->instance->fsa,
+            bucket_size(num_entries + 1));
+        if (bucket)
+            memcpy(new_bucket->entries, bucket->entries, num_entries * sizeof(MVMConcHashEntry));
+        new_bucket->num_entries = num_entries + 1;
+        new_bucket->entries[num_entries].key   = key;
+        new_bucket->entries[num_entries].value = value;
+        new_bucket->entries[num_entries].hash  = hash;
+        MVM_gc_write_barrier(tc, &(root->header), (MVMCollectable *)key);
+        MVM_store(&table->buckets[index], new_bucket);
+        if (bucket)
+            MVM_fixed_size_free_at_safepoint(tc, tc->instance->fsa,
+                bucket_size(num_entries), bucket);
+        MVM_incr(&body->elems);
+    }
+}
+
+/* Doubles the number of buckets, if there are still too many entries once
+ * we hold all of the stripe locks. */
+static void grow(MVMThreadContext *tc, MVMObject *root) {
+    MVMConcHashLocks *locks = ((MVMConcHashBody *)OBJECT_BODY(root))->locks;
+    MVMConcHashBody  *body;
+    MVMConcHashTable *table;
+    MVMuint32 i;
+
+    MVMROOT(tc, root, {
+        for (i = 0; i < MVM_CONC_HASH_STRIPES; i++)
+            lock_stripe(tc, &locks->stripes[i]);
+    });
+    body  = (MVMConcHashBody *)OBJECT_BODY(root);
+    table = body->table;
+
+    if (MVM_load(&body->elems) > (AO_t)table->num_buckets * MVM_CONC_HASH_LOAD_FACTOR) {
+        /* Each old bucket splits into two, at the same index and that plus
+         * the old number of buckets. */
+        MVMuint32 old_num = table->num_buckets;
+        MVMConcHashTable *new_table = alloc_table(tc, old_num * 2);
+        for (i = 0; i < old_num; i++) {
+            MVMConcHashBucket *bucket = table->buckets[i];
+            if (bucket) {
+                MVMConcHashBucket *split[2] = { NULL, NULL };
+                MVMuint32 count[2] = { 0, 0 };
+                MVMuint32 j;
+                for (j = 0; j < bucket->num_entries; j++)
+                    count[(bucket->entries[j].hash & old_num) != 0]++;
+                for (j = 0; j < 2; j++) {
+                    if (count[j]) {
+                        split[j] = MVM_fixed_size_alloc(tc, tc->instance->fsa,
+                            bucket_size(count[j]));
+                        split[j]->num_entries = 0;
+                    }
+                }
+                for (j = 0; j < bucket->num_entries; j++) {
+                    MVMConcHashBucket *to = split[(bucket->entries[j].hash & old_num) != 0];
+                    to->entries[to->num_entries++] = bucket->entries[j];
+                }
+                new_table->buckets[i]           = split[0];
+                new_table->buckets[i + old_num] = split[1];
+                MVM_fixed_size_free_at_safepoint(tc, tc->instance->fsa,
+                    bucket_size(bucket->num_entries), bucket);
+            }
+        }
+        MVM_barrier();
+        body->table = new_table;
+        MVM_fixed_size_free_at_safepoint(tc, tc->instance->fsa,
+            table_size(old_num), table);
+    }
+
+    for (i = 0; i < MVM_CONC_HASH_STRIPES; i++)
+        uv_mutex_unlock(&locks->stripes[i]);
+}
+
+/* Grows the table if a write left it too full. */
+static void maybe_grow(MVMThreadContext *tc, MVMObject *root) {
+    MVMConcHashBody *body = (MVMConcHashBody *)OBJECT_BODY(root);
+    if (MVM_load(&body->elems) > (AO_t)body->table->num_buckets * MVM_CONC_HASH_LOAD_FACTOR)
+        grow(tc, root);
+}
+
+/* Creates a new type object of this representation, and associates it with
+ * the given HOW. */
+static MVMObject * type_object_for(MVMThreadContext *tc, MVMObject *HOW) {
+    MVMSTable *st = MVM_gc_allocate_stable(tc, &ConcHash_this_repr, HOW);
+
+    MVMROOT(tc, st, {
+        MVMObject *obj = MVM_gc_allocate_type_object(tc, st);
+        MVM_ASSIGN_REF(tc, &(st->header), st->WHAT, obj);
+        st->size = sizeof(MVMConcHash);
+    });
+
+    return st->WHAT;
+}
+
+/* Initializes a new instance. */
+static void initialize(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data) {
+    init_body(tc, (MVMConcHashBody *)data);
+}
+
+/* Copies the body of one object to another. The source may be being
+ * changed by other threads, in which case we copy what we see. */
+static void copy_to(MVMThreadContext *tc, MVMSTable *st, void *src, MVMObject *dest_root, void *dest) {
+    MVMConcHashBody  *src_body  = (MVMConcHashBody *)src;
+    MVMConcHashBody  *dest_body = (MVMConcHashBody *)dest;
+    MVMConcHashTable *table     = (MVMConcHashTable *)MVM_load(&src_body->table);
+    MVMuint32 i, j;
+    init_body(tc, dest_body);
+    for (i = 0; i < table->num_buckets; i++) {
+        MVMConcHashBucket *bucket = (MVMConcHashBucket *)MVM_load(&table->buckets[i]);
+        if (bucket) {
+            for (j = 0; j < bucket->num_entries; j++) {
+                MVMConcHashEntry *entry = &bucket->entries[j];
+                store_value(tc, dest_root, dest_body, entry->key, entry->hash,
+                    (MVMObject *)MVM_load(&entry->value));
+            }
+        }
+    }
+    maybe_grow(tc, dest_root);
+}
+
+/* Adds held objects to the GC worklist. */
+static void gc_mark(MVMThreadContext *tc, MVMSTable *st, void *data, MVMGCWorklist *worklist) {
+    MVMConcHashBody *body = (MVMConcHashBody *)data;
+    MVMConcHashTable *table = body->table;
+    MVMuint32 i, j;
+    if (!table)
+        return;
+    for (i = 0; i < table->num_buckets; i++) {
+        MVMConcHashBucket *bucket = table->buckets[i];
+        if (bucket) {
+            for (j = 0; j < bucket->num_entries; j++) {
+                MVM_gc_worklist_add(tc, worklist, &bucket->entries[j].key);
+                MVM_gc_worklist_add(tc, worklist, &bucket->entries[j].value);
+            }
+        }
+    }
+}
+
+/* Called by the VM in order to free memory associated with this object. */
+static void gc_free(MVMThreadContext *tc, MVMObject *obj) {
+    MVMConcHash *h = (MVMConcHash *)obj;
+    MVMConcHashTable *table = h->body.table;
+    MVMuint32 i;
+    if (table) {
+        for (i = 0; i < table->num_buckets; i++) {
+            MVMConcHashBucket *bucket = table->buckets[i];
+            if (bucket)
+                MVM_fixed_size_free(tc, tc->instance->fsa,
+                    bucket_size(bucket->num_entries), bucket);
+        }
+        MVM_fixed_size_free(tc, tc->instance->fsa, table_size(table->num_buckets), table);
+        h->body.table = NULL;
+    }
+    if (h->body.locks) {
+        for (i = 0; i < MVM_CONC_HASH_STRIPES; i++)
+            uv_mutex_destroy(&h->body.locks->stripes[i]);
+        MVM_free(h->body.locks);
+        h->body.locks = NULL;
+    }
+}
+
+static void at_key(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMObject *key_obj, MVMRegister *result, MVMuint16 kind) {
+    MVMConcHashBody *body = (MVMConcHashBody *)data;
+    MVMString *key = get_string_key(tc, key_obj);
+    MVMuint32 hash = hash_key(tc, key);
+    MVMConcHashEntry *entry;
+    if (kind != MVM_reg_obj)
+        MVM_exception_throw_adhoc(tc,
+            "ConcHash representation does not support native type storage");
+    entry = find_entry(tc, (MVMConcHashTable *)MVM_load(&body->table), key, hash);
+    result->o = entry ? (MVMObject *)MVM_load(&entry->value) : tc->instance->VMNull;
+}
+
+static void bind_key(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMObject *key_obj, MVMRegister value, MVMuint16 kind) {
+    MVMConcHashBody *body = (MVMConcHashBody *)data;
+    MVMString *key = get_string_key(tc, key_obj);
+    MVMuint32 hash = hash_key(tc, key);
+    uv_mutex_t *lock = &body->locks->stripes[hash & (MVM_CONC_HASH_STRIPES - 1)];
+    MVMObject *to_bind = value.o;
+
+    if (kind != MVM_reg_obj)
+        MVM_exception_throw_adhoc(tc,
+            "ConcHash representation does not support native type storage");
+
+    MVMROOT(tc, root, {
+    MVMROOT(tc, key, {
+    MVMROOT(tc, to_bind, {
+        lock_stripe(tc, lock);
+    });
+    });
+    });
+    store_value(tc, root, (MVMConcHashBody *)OBJECT_BODY(root), key, hash, to_bind);
+    uv_mutex_unlock(lock);
+    maybe_grow(tc, root);
+}
+
+static MVMuint64 elems(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data) {
+    MVMConcHashBody *body = (MVMConcHashBody *)data;
+    return MVM_load(&body->elems);
+}
+
+static MVMint64 exists_key(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMObject *key_obj) {
+    MVMConcHashBody *body = (MVMConcHashBody *)data;
+    MVMString *key = get_string_key(tc, key_obj);
+    MVMuint32 hash = hash_key(tc, key);
+    return find_entry(tc, (MVMConcHashTable *)MVM_load(&body->table), key, hash) != NULL;
+}
+
+static void delete_key(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMObject *key_obj) {
+    MVMConcHashBody *body = (MVMConcHashBody *)data;
+    MVMString *key = get_string_key(tc, key_obj);
+    MVMuint32 hash = hash_key(tc, key);
+    uv_mutex_t *lock = &body->locks->stripes[hash & (MVM_CONC_HASH_STRIPES - 1)];
+    MVMConcHashTable *table;
+    MVMConcHashEntry *entry;
+
+    MVMROOT(tc, root, {
+    MVMROOT(tc, key, {
+        lock_stripe(tc, lock);
+    });
+    });
+    body  = (MVMConcHashBody *)OBJECT_BODY(root);
+    table = body->table;
+    entry = find_entry(tc, table, key, hash);
+    if (entry) {
+        /* Make a copy of the bucket without the entry, or no bucket at all
+         * if it was the only one. */
+        MVMuint32 index = hash & (table->num_buckets - 1);
+        MVMConcHashBucket *bucket = table->buckets[index];
+        MVMuint32 num_entries = bucket->num_entries;
+        MVMConcHashBucket *new_bucket = NULL;
+        if (num_entries > 1) {
+            MVMuint32 skip = entry - bucket->entries;
+            new_bucket = MVM_fixed_size_alloc(tc, tc->instance->fsa,
+                bucket_size(num_entries - 1));
+            new_bucket->num_entries = num_entries - 1;
+            memcpy(new_bucket->entries, bucket->entries, skip * sizeof(MVMConcHashEntry));
+            memcpy(new_bucket->entries + skip, bucket->entries + skip + 1,
+                (num_entries - skip - 1) * sizeof(MVMConcHashEntry));
+        }
+        MVM_store(&table->buckets[index], new_bucket);
+        MVM_fixed_size_free_at_safepoint(tc, tc->instance->fsa,
+            bucket_size(num_entries), bucket);
+        MVM_decr(&body->elems);
+    }
+    uv_mutex_unlock(lock);
+}
+
+static MVMStorageSpec get_value_storage_spec(MVMThreadContext *tc, MVMSTable *st) {
+    MVMStorageSpec spec;
+    spec.inlineable      = MVM_STORAGE_SPEC_REFERENCE;
+    spec.boxed_primitive = MVM_STORAGE_SPEC_BP_NONE;
+    spec.can_box         = 0;
+    spec.bits            = 0;
+    spec.align           = 0;
+    spec.is_unsigned     = 0;
+    return spec;
+}
+
+static const MVMStorageSpec storage_spec = {
+    MVM_STORAGE_SPEC_REFERENCE, /* inlineable */
+    0,                          /* bits */
+    0,                          /* align */
+    MVM_STORAGE_SPEC_BP_NONE,   /* boxed_primitive */
+    0,                          /* can_box */
+    0,                          /* is_unsigned */
+};
+
+/* Gets the storage specification for this representation. */
+static const MVMStorageSpec * get_storage_spec(MVMThreadContext *tc, MVMSTable *st) {
+    return &storage_spec;
+}
+
+/* Compose the representation. */
+static void compose(MVMThreadContext *tc, MVMSTable *st, MVMObject *info) {
+    /* Nothing to do for this REPR. */
+}
+
+/* Set the size of the STable. */
+static void deserialize_stable_size(MVMThreadContext *tc, MVMSTable *st, MVMSerializationReader *reader) {
+    st->size = sizeof(MVMConcHash);
+}
+
+static MVMuint64 unmanaged_size(MVMThreadContext *tc, MVMSTable *st, void *data) {
+    MVMConcHashBody *body = (MVMConcHashBody *)data;
+    MVMuint64 size = sizeof(MVMConcHashLocks);
+    MVMuint32 i;
+    if (body->table) {
+        size += table_size(body->table->num_buckets);
+        for (i = 0; i < body->table->num_buckets; i++)
+            if (body->table->buckets[i])
+                size += bucket_size(body->table->buckets[i]->num_entries);
+    }
+    return size;
+}
+
+/* Initializes the representation. */
+const MVMREPROps * MVMConcHash_initialize(MVMThreadContext *tc) {
+    return &ConcHash_this_repr;
+}
+
+static const MVMREPROps ConcHash_this_repr = {
+    type_object_for,
+    MVM_gc_allocate_object,
+    initialize,
+    copy_to,
+    MVM_REPR_DEFAULT_ATTR_FUNCS,
+    MVM_REPR_DEFAULT_BOX_FUNCS,
+    MVM_REPR_DEFAULT_POS_FUNCS,
+    {
+        at_key,
+        bind_key,
+        exists_key,
+        delete_key,
+        get_value_storage_spec
+    },    /* ass_funcs */
+    elems,
+    get_storage_spec,
+    NULL, /* change_type */
+    NULL, /* serialize */
+    NULL, /* deserialize */
+    NULL, /* serialize_repr_data */
+    NULL, /* deserialize_repr_data */
+    deserialize_stable_size,
+    gc_mark,
+    gc_free,
+    NULL, /* gc_cleanup */
+    NULL, /* gc_mark_repr_data */
+    NULL, /* gc_free_repr_data */
+    compose,
+    NULL, /* spesh */
+    "ConcHash", /* name */
+    MVM_REPR_ID_ConcHash,
+    unmanaged_size,
+    NULL, /* describe_refs */
+};
+
+/* Sets the value for a key to value if it is currently expected, where a
+ * missing key counts as VMNull. Returns the value seen, so the swap took
+ * place if that is expected. */
+MVMObject * MVM_conchash_cas(MVMThreadContext *tc, MVMObject *hash, MVMString *key,
+        MVMObject *expected, MVMObject *value) {
+    MVMConcHashBody  *body;
+    MVMConcHashEntry *entry;
+    MVMObject *seen;
+    MVMuint32 hash_code;
+    uv_mutex_t *lock;
+
+    if (REPR(hash)->ID != MVM_REPR_ID_ConcHash || !IS_CONCRETE(hash))
+        MVM_exception_throw_adhoc(tc,
+            "caskey_o requires a concrete object with REPR ConcHash");
+    if (MVM_is_null(tc, (MVMObject *)key))
+        MVM_exception_throw_adhoc(tc, "ConcHash representation requires MVMString keys");
+    if (!expected)
+        expected = tc->instance->VMNull;
+    if (!value)
+        value = tc->instance->VMNull;
+
+    hash_code = hash_key(tc, key);
+    body      = &((MVMConcHash *)hash)->body;
+    lock      = &body->locks->stripes[hash_code & (MVM_CONC_HASH_STRIPES - 1)];
+    MVMROOT(tc, hash, {
+    MVMROOT(tc, key, {
+    MVMROOT(tc, expected, {
+    MVMROOT(tc, value, {
+        lock_stripe(tc, lock);
+    });
+    });
+    });
+    });
+    body  = &((MVMConcHash *)hash)->body;
+    entry = find_entry(tc, body->table, key, hash_code);
+    seen  = entry ? entry->value : tc->instance->VMNull;
+    if (seen == expected)
+        store_value(tc, hash, body, key, hash_code, value);
+    uv_mutex_unlock(lock);
+
+    MVMROOT(tc, seen, {
+        maybe_grow(tc, hash);
+    });
+    return seen;
+}
@@ -0,0 +1,59 @@
+/* Representation of a hash with string keys that many threads may use at
+ * once. Lookups take no locks. Each bucket is an array of entries that is
+ * never changed once visible, apart from the values in it; adding or
+ * removing a key makes a new array, and the old one is freed at the next
+ * safepoint, since readers may still be looking at it. Writers lock one of
+ * a number of stripes, picked from the key's hash, so writes to different
+ * keys seldom contend; growing the table takes all of the stripes. */
+
+/* The number of stripe locks, and the number of buckets we start with,
+ * which must be at least the number of stripes so that each bucket is
+ * covered by just one of them. */
+#define MVM_CONC_HASH_STRIPES         16
+#define MVM_CONC_HASH_INITIAL_BUCKETS 16
+
+/* The table grows when there are more than this many entries per bucket. */
+#define MVM_CONC_HASH_LOAD_FACTOR 2
+
+struct MVMConcHashEntry {
+    MVMString *key;
+    MVMObject *value;
+    MVMuint32  hash;
+};
+
+struct MVMConcHashBucket {
+    MVMuint32        num_entries;
+    MVMConcHashEntry entries[1];
+};
+
+/* The buckets; an empty bucket is NULL. Replaced as a whole when growing. */
+struct MVMConcHashTable {
+    MVMuint32          num_buckets;
+    MVMConcHashBucket *buckets[1];
+};
+
+/* The stripe locks; these can't live in the object body directly as they
+ * are sensitive to being moved. */
+struct MVMConcHashLocks {
+    uv_mutex_t stripes[MVM_CONC_HASH_STRIPES];
+};
+
+struct MVMConcHashBody {
+    MVMConcHashTable *table;
+
+    /* Number of entries in the hash. */
+    AO_t elems;
+
+    MVMConcHashLocks *locks;
+};
+struct MVMConcHash {
+    MVMObject common;
+    MVMConcHashBody body;
+};
+
+/* Function for REPR setup. */
+const MVMREPROps * MVMConcHash_initialize(MVMThreadContext *tc);
+
+/* Operations on concurrent hashes. */
+MVMObject * MVM_conchash_cas(MVMThreadContext *tc, MVMObject *hash, MVMString *key,
+    MVMObject *expected, MVMObject *value);
@@ -25,6 +25,8 @@ static void copy_to(MVMThreadContext *tc, MVMSTable *st, void *src, MVMObject *d
     dest_body->num_strands      = src_body->num_strands;
     dest_body->num_graphs       = src_body->num_graphs;
     dest_body->cached_hash_code = src_body->cached_hash_code;
+    dest_body->interned         = 0;
+    dest_body->strand_offsets_ready = src_body->strand_offsets_ready;
     switch (dest_body->storage_type) {
         case MVM_STRING_GRAPHEME_32:
             if (dest_body->num_graphs) {
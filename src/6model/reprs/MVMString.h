@@ -15,10 +15,11 @@
  * repetition count.
  */
 
-/* Kinds of grapheme we may hold in a string. */
+/* Kinds of grapheme we may hold in a string. 8-bit storage holds Latin-1,
+ * that is graphemes 0 to 255; synthetics always need 32-bit storage. */
 typedef MVMint32 MVMGrapheme32;
 typedef MVMint8  MVMGraphemeASCII;
-typedef MVMint8  MVMGrapheme8;       /* Future use */
+typedef MVMuint8 MVMGrapheme8;
 
 /* What kind of data is a string storing? */
 #define MVM_STRING_GRAPHEME_32      0
@@ -35,6 +36,11 @@ typedef MVMint32 MVMCodepoint;
 /* Maximum number of strands we will have. */
 #define MVM_STRING_MAX_STRANDS  64
 
+/* Strand strings with at least this many strands get the offset at which
+ * each strand starts filled in on first random access into them, so that
+ * the strand holding a position is found by binary search. */
+#define MVM_STRING_STRAND_INDEX_MIN  8
+
 /* The body of a string. */
 struct MVMStringBody {
     union {
@@ -48,6 +54,14 @@ struct MVMStringBody {
     MVMuint16 num_strands;
     MVMuint32 num_graphs;
     MVMint32  cached_hash_code;
+
+    /* Whether the string is in the VM-wide table of interned strings, which
+     * strand strings never are. This and the next flag go in what would
+     * otherwise be padding. */
+    MVMuint8  interned;
+
+    /* For strand strings, whether the offset of each strand is filled in. */
+    MVMuint8  strand_offsets_ready;
 };
 
 /* A strand of a string. */
@@ -61,6 +75,10 @@ struct MVMStringStrand {
 
     /* Number of repetitions. */
     MVMuint32 repetitions;
+
+    /* The position in the strand string at which this strand starts; only
+     * meaningful once the string's strand_offsets_ready is set. */
+    MVMStringIndex offset;
 };
 
 /* The MVMString, with header and body. */
@@ -1547,6 +1547,31 @@ static void spesh(MVMThreadContext *tc, MVMSTable *st, MVMSpeshGraph *g, MVMSpes
         }
         break;
     }
+    case MVM_OP_add_I:
+    case MVM_OP_sub_I:
+    case MVM_OP_mul_I: {
+        /* If the result type boxes a big integer and needs no initialization
+         * other than that of the big integer itself, small operands can be
+         * handled without going through the REPR, so pass along where the
+         * body lives. The specialized op sets up the big integer body. */
+        MVMuint16 slot = repr_data->unbox_slots
+            ? repr_data->unbox_slots[MVM_REPR_ID_P6bigint]
+            : MVM_P6OPAQUE_NO_UNBOX_SLOT;
+        if (slot != MVM_P6OPAQUE_NO_UNBOX_SLOT
+                && (repr_data->initialize_slots[0] < 0
+                    || (repr_data->initialize_slots[0] == slot
+                        && repr_data->initialize_slots[1] < 0))
+                && !(st->mode_flags & MVM_FINALIZE_TYPE)) {
+            MVMSpeshOperand *orig_operands = ins->operands;
+            ins->info = MVM_op_get_op(opcode == MVM_OP_add_I ? MVM_OP_sp_add_I :
+                                      opcode == MVM_OP_sub_I ? MVM_OP_sp_sub_I :
+                                                               MVM_OP_sp_mul_I);
+            ins->operands = MVM_spesh_alloc(tc, g, 5 * sizeof(MVMSpeshOperand));
+            memcpy(ins->operands, orig_operands, 4 * sizeof(MVMSpeshOperand));
+            ins->operands[4].lit_i16 = repr_data->attribute_offsets[slot];
+        }
+        break;
+    }
     }
 }
 
@@ -0,0 +1,492 @@
+#include "moar.h"
+
+/* This representation's function pointer table. */
+static const MVMREPROps StringBuilder_this_repr;
+
+/* Creates a new type object of this representation, and associates it with
+ * the given HOW. */
+static MVMObject * type_object_for(MVMThreadContext *tc, MVMObject *HOW) {
+    MVMSTable *st  = MVM_gc_allocate_stable(tc, &StringBuilder_this_repr, HOW);
+
+    MVMROOT(tc, st, {
+        MVMObject *obj = MVM_gc_allocate_type_object(tc, st);
+        MVM_ASSIGN_REF(tc, &(st->header), st->WHAT, obj);
+        st->size = sizeof(MVMStringBuilder);
+    });
+
+    return st->WHAT;
+}
+
+/* Copies the body of one object to another. */
+static void copy_to(MVMThreadContext *tc, MVMSTable *st, void *src, MVMObject *dest_root, void *dest) {
+    MVM_exception_throw_adhoc(tc, "Cannot copy object with representation StringBuilder");
+}
+
+/* Called by the VM to mark any GCable items. */
+static void gc_mark(MVMThreadContext *tc, MVMSTable *st, void *data, MVMGCWorklist *worklist) {
+    MVMStringBuilderBody *body = (MVMStringBuilderBody *)data;
+    MVMuint16 i;
+    for (i = 0; i < body->num_chunks; i++)
+        MVM_gc_worklist_add(tc, worklist, &(body->chunks[i].blob_string));
+    MVM_gc_worklist_add(tc, worklist, &(body->last_result));
+}
+
+/* Called by the VM in order to free memory associated with this object. */
+static void gc_free(MVMThreadContext *tc, MVMObject *obj) {
+    MVMStringBuilder *sb = (MVMStringBuilder *)obj;
+    MVM_free(sb->body.chunks);
+}
+
+/* The number of elements is the number of graphemes built so far. */
+static MVMuint64 elems(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data) {
+    MVMStringBuilderBody *body = (MVMStringBuilderBody *)data;
+    return body->num_graphs;
+}
+
+static const MVMStorageSpec storage_spec = {
+    MVM_STORAGE_SPEC_REFERENCE, /* inlineable */
+    0,                          /* bits */
+    0,                          /* align */
+    MVM_STORAGE_SPEC_BP_NONE,   /* boxed_primitive */
+    0,                          /* can_box */
+    0,                          /* is_unsigned */
+};
+
+
+/* Gets the storage specification for this representation. */
+static const MVMStorageSpec * get_storage_spec(MVMThreadContext *tc, MVMSTable *st) {
+    return &storage_spec;
+}
+
+/* Compose the representation. */
+static void compose(MVMThreadContext *tc, MVMSTable *st, MVMObject *info) {
+    /* Nothing to do for this REPR. */
+}
+
+/* Set the size of the STable. */
+static void deserialize_stable_size(MVMThreadContext *tc, MVMSTable *st, MVMSerializationReader *reader) {
+    st->size = sizeof(MVMStringBuilder);
+}
+
+/* Calculates the non-GC-managed memory we hold on to. */
+static MVMuint64 unmanaged_size(MVMThreadContext *tc, MVMSTable *st, void *data) {
+    MVMStringBuilderBody *body = (MVMStringBuilderBody *)data;
+    return body->alloc_chunks * sizeof(MVMStringBuilderChunk);
+}
+
+/* Initializes the representation. */
+const MVMREPROps * MVMStringBuilder_initialize(MVMThreadContext *tc) {
+    return &StringBuilder_this_repr;
+}
+
+static const MVMREPROps StringBuilder_this_repr = {
+    type_object_for,
+    MVM_gc_allocate_object,
+    NULL, /* initialize */
+    copy_to,
+    MVM_REPR_DEFAULT_ATTR_FUNCS,
+    MVM_REPR_DEFAULT_BOX_FUNCS,
+    MVM_REPR_DEFAULT_POS_FUNCS,
+    MVM_REPR_DEFAULT_ASS_FUNCS,
+    elems,
+    get_storage_spec,
+    NULL, /* change_type */
+    NULL, /* serialize */
+    NULL, /* deserialize */
+    NULL, /* serialize_repr_data */
+    NULL, /* deserialize_repr_data */
+    deserialize_stable_size,
+    gc_mark,
+    gc_free,
+    NULL, /* gc_cleanup */
+    NULL, /* gc_mark_repr_data */
+    NULL, /* gc_free_repr_data */
+    compose,
+    NULL, /* spesh */
+    "StringBuilder", /* name */
+    MVM_REPR_ID_StringBuilder,
+    unmanaged_size,
+    NULL, /* describe_refs */
+};
+
+/* Assert that the passed object really is a string builder; throw if not. */
+static MVMStringBuilder * ensure_builder(MVMThreadContext *tc, MVMObject *builder, const char *op) {
+    if (REPR(builder)->ID != MVM_REPR_ID_StringBuilder || !IS_CONCRETE(builder))
+        MVM_exception_throw_adhoc(tc,
+            "Operation '%s' can only work on an object with the StringBuilder representation",
+            op);
+    return (MVMStringBuilder *)builder;
+}
+
+MVM_STATIC_INLINE int can_fit_into_8bit(MVMGrapheme32 g) {
+    return 0 <= g && g <= 255;
+}
+
+/* Checks if any grapheme in the given range of a flat string will not fit
+ * into an 8-bit chunk. */
+static MVMint32 range_needs_wide(MVMThreadContext *tc, MVMString *s, MVMStringIndex start,
+        MVMStringIndex end) {
+    if (s->body.storage_type == MVM_STRING_GRAPHEME_32) {
+        MVMGrapheme32 *blob = s->body.storage.blob_32;
+        MVMStringIndex i;
+        for (i = start; i < end; i++)
+            if (!can_fit_into_8bit(blob[i]))
+                return 1;
+    }
+    return 0;
+}
+static MVMint32 string_needs_wide(MVMThreadContext *tc, MVMString *s) {
+    if (s->body.storage_type == MVM_STRING_STRAND) {
+        MVMuint16 i;
+        for (i = 0; i < s->body.num_strands; i++) {
+            MVMStringStrand *strand = &(s->body.storage.strands[i]);
+            if (range_needs_wide(tc, strand->blob_string, strand->start, strand->end))
+                return 1;
+        }
+        return 0;
+    }
+    return range_needs_wide(tc, s, 0, s->body.num_graphs);
+}
+
+/* Copies a range of a flat string onto the end of a chunk that we own and
+ * that has room for it. The blob string's grapheme count is left alone; it
+ * is fixed at the chunk's capacity when the chunk is allocated. */
+static void copy_graphemes(MVMThreadContext *tc, MVMStringBuilderChunk *chunk, MVMString *src,
+        MVMStringIndex start, MVMStringIndex end) {
+    MVMStringBody  *dest = &(chunk->blob_string->body);
+    MVMStringIndex  n    = end - start;
+    MVMStringIndex  i;
+    if (dest->storage_type == MVM_STRING_GRAPHEME_32) {
+        MVMGrapheme32 *to = dest->storage.blob_32 + chunk->end;
+        if (src->body.storage_type == MVM_STRING_GRAPHEME_32)
+            memcpy(to, src->body.storage.blob_32 + start, n * sizeof(MVMGrapheme32));
+        else
+            for (i = 0; i < n; i++)
+                to[i] = src->body.storage.blob_8[start + i];
+    }
+    else {
+        MVMGrapheme8 *to = dest->storage.blob_8 + chunk->end;
+        if (src->body.storage_type == MVM_STRING_GRAPHEME_32)
+            for (i = 0; i < n; i++)
+                to[i] = src->body.storage.blob_32[start + i];
+        else
+            memcpy(to, src->body.storage.blob_8 + start, n * sizeof(MVMGrapheme8));
+    }
+    chunk->end += n;
+}
+
+/* Adds a chunk to the builder, growing the chunk list as needed. */
+static MVMStringBuilderChunk * add_chunk(MVMThreadContext *tc, MVMStringBuilder *sb,
+        MVMString *blob_string, MVMStringIndex start, MVMStringIndex end,
+        MVMStringIndex capacity) {
+    MVMStringBuilderChunk *chunk;
+    if (sb->body.num_chunks == sb->body.alloc_chunks) {
+        sb->body.alloc_chunks = sb->body.alloc_chunks ? sb->body.alloc_chunks * 2 : 4;
+        sb->body.chunks = MVM_realloc(sb->body.chunks,
+            sb->body.alloc_chunks * sizeof(MVMStringBuilderChunk));
+    }
+    chunk = &(sb->body.chunks[sb->body.num_chunks++]);
+    MVM_ASSIGN_REF(tc, &(sb->common.header), chunk->blob_string, blob_string);
+    chunk->start    = start;
+    chunk->end      = end;
+    chunk->capacity = capacity;
+    if (blob_string->body.storage_type == MVM_STRING_GRAPHEME_32)
+        sb->body.wide = 1;
+    return chunk;
+}
+
+/* Makes sure the last chunk has room for the specified number of graphemes,
+ * allocating a new chunk if not. Trailing chunks less than twice as big as
+ * what follows them are copied into the new chunk; should that still leave
+ * too many chunks for a strand string, everything is copied. Since chunks we
+ * allocate at least double in size, a chunk of ours is only copied when what
+ * is appended is at least half its size. */
+static void reserve(MVMThreadContext *tc, MVMStringBuilder *sb, MVMuint32 needed,
+        MVMint32 need_wide) {
+    MVMStringBuilderChunk  merged;
+    MVMString             *blob_string;
+    MVMuint64              capacity;
+    MVMuint64              merged_graphs;
+    MVMuint16              first, i;
+    MVMuint64              last_capacity = 0;
+    if (need_wide)
+        sb->body.wide = 1;
+    if (sb->body.num_chunks) {
+        MVMStringBuilderChunk *last = &(sb->body.chunks[sb->body.num_chunks - 1]);
+        if ((MVMuint64)last->end + needed <= last->capacity && (!sb->body.wide ||
+                last->blob_string->body.storage_type == MVM_STRING_GRAPHEME_32))
+            return;
+        last_capacity = last->capacity;
+    }
+    if ((MVMuint64)sb->body.num_graphs + needed > 0xFFFFFFFFULL)
+        MVM_exception_throw_adhoc(tc, "Can't build a string of more than %u graphemes",
+            0xFFFFFFFFU);
+
+    /* Pick the chunks to copy. */
+    merged_graphs = needed;
+    first         = sb->body.num_chunks;
+    while (first > 0) {
+        MVMStringBuilderChunk *chunk = &(sb->body.chunks[first - 1]);
+        MVMuint64 length = chunk->end - chunk->start;
+        if (length >= 2 * merged_graphs)
+            break;
+        merged_graphs += length;
+        first--;
+    }
+    if (first >= MVM_STRING_MAX_STRANDS) {
+        first         = 0;
+        merged_graphs = (MVMuint64)sb->body.num_graphs + needed;
+    }
+
+    /* Leave room to double, and make chunks of ours at least double in size,
+     * so appends are amortized O(1). */
+    capacity = 2 * merged_graphs;
+    if (capacity < 2 * last_capacity)
+        capacity = 2 * last_capacity;
+    if (capacity < MVM_STRING_BUILDER_MIN_CHUNK)
+        capacity = MVM_STRING_BUILDER_MIN_CHUNK;
+    if (capacity > 0xFFFFFFFFULL)
+        capacity = 0xFFFFFFFFULL;
+
+    MVMROOT(tc, sb, {
+        blob_string = (MVMString *)MVM_repr_alloc_init(tc, tc->instance->VMString);
+    });
+    if (sb->body.wide) {
+        blob_string->body.storage_type   = MVM_STRING_GRAPHEME_32;
+        blob_string->body.storage.blob_32 = MVM_calloc(capacity, sizeof(MVMGrapheme32));
+    }
+    else {
+        blob_string->body.storage_type   = MVM_STRING_GRAPHEME_8;
+        blob_string->body.storage.blob_8 = MVM_calloc(capacity, sizeof(MVMGrapheme8));
+    }
+    blob_string->body.num_graphs = (MVMStringIndex)capacity;
+
+    merged.blob_string = blob_string;
+    merged.start       = 0;
+    merged.end         = 0;
+    merged.capacity    = (MVMStringIndex)capacity;
+    for (i = first; i < sb->body.num_chunks; i++) {
+        MVMStringBuilderChunk *chunk = &(sb->body.chunks[i]);
+        copy_graphemes(tc, &merged, chunk->blob_string, chunk->start, chunk->end);
+    }
+    sb->body.num_chunks = first;
+    add_chunk(tc, sb, blob_string, 0, merged.end, merged.capacity);
+}
+
+/* Empties the builder, then sets it up to continue from the specified
+ * string. Where possible we just refer to the string, or its strands. */
+static void append_string(MVMThreadContext *tc, MVMStringBuilder *sb, MVMString *s);
+static void reset(MVMThreadContext *tc, MVMStringBuilder *sb, MVMString *s) {
+    MVMuint32 graphs = MVM_string_graphs_nocheck(tc, s);
+    sb->body.num_chunks  = 0;
+    sb->body.num_graphs  = 0;
+    sb->body.wide        = 0;
+    sb->body.last_result = NULL;
+    if (graphs == 0)
+        return;
+    if (s->body.storage_type == MVM_STRING_STRAND) {
+        MVMuint32 pieces = 0;
+        MVMuint16 i;
+        for (i = 0; i < s->body.num_strands; i++)
+            pieces += s->body.storage.strands[i].repetitions + 1;
+        if (pieces > MVM_STRING_MAX_STRANDS) {
+            append_string(tc, sb, s);
+            return;
+        }
+        for (i = 0; i < s->body.num_strands; i++) {
+            MVMStringStrand *strand = &(s->body.storage.strands[i]);
+            MVMuint32 r;
+            for (r = 0; r <= strand->repetitions; r++)
+                add_chunk(tc, sb, strand->blob_string, strand->start, strand->end, 0);
+        }
+    }
+    else {
+        add_chunk(tc, sb, s, 0, graphs, 0);
+    }
+    sb->body.num_graphs    = graphs;
+    sb->body.last_grapheme = MVM_string_get_grapheme_at_nocheck(tc, s, graphs - 1);
+}
+
+/* Produces a strand string over the chunks. Appending later only writes past
+ * the end of the last chunk, which the result does not cover, so the chunks
+ * can be carried on with. Only a chunk that is full, and so will never be
+ * written again, is handed out as a string in its own right. */
+static MVMString * to_strand_string(MVMThreadContext *tc, MVMStringBuilder *sb) {
+    MVMString *result;
+    MVMuint16  i;
+    if (sb->body.num_graphs == 0)
+        return tc->instance->str_consts.empty;
+    if (sb->body.num_chunks == 1) {
+        MVMStringBuilderChunk *chunk = &(sb->body.chunks[0]);
+        if (chunk->start == 0 && chunk->end == chunk->blob_string->body.num_graphs)
+            return chunk->blob_string;
+    }
+    MVMROOT(tc, sb, {
+        result = (MVMString *)MVM_repr_alloc_init(tc, tc->instance->VMString);
+    });
+    result->body.storage_type    = MVM_STRING_STRAND;
+    result->body.storage.strands = MVM_malloc(sb->body.num_chunks * sizeof(MVMStringStrand));
+    for (i = 0; i < sb->body.num_chunks; i++) {
+        MVMStringBuilderChunk *chunk  = &(sb->body.chunks[i]);
+        MVMStringStrand       *strand = &(result->body.storage.strands[i]);
+        strand->blob_string = chunk->blob_string;
+        strand->start       = chunk->start;
+        strand->end         = chunk->end;
+        strand->repetitions = 0;
+    }
+    result->body.num_strands = sb->body.num_chunks;
+    result->body.num_graphs  = sb->body.num_graphs;
+    return result;
+}
+
+/* Appends a string to the builder. */
+static void append_string(MVMThreadContext *tc, MVMStringBuilder *sb, MVMString *s) {
+    MVMuint32 graphs = MVM_string_graphs_nocheck(tc, s);
+    MVMStringBuilderChunk *chunk;
+    if (graphs == 0)
+        return;
+
+    /* If the join may need renormalizing, leave that to concatenation and
+     * carry on from its result. This only happens when combiners or a \r\n
+     * pair straddle the join, so is not worth doing better. */
+    if (sb->body.num_graphs && !MVM_nfg_is_concat_stable_graphemes(tc,
+            sb->body.last_grapheme, MVM_string_get_grapheme_at_nocheck(tc, s, 0))) {
+        MVMROOT(tc, sb, {
+            MVMString *so_far;
+            MVMROOT(tc, s, {
+                so_far = to_strand_string(tc, sb);
+            });
+            reset(tc, sb, MVM_string_concatenate(tc, so_far, s));
+        });
+        return;
+    }
+
+    MVMROOT(tc, sb, {
+        MVMROOT(tc, s, {
+            reserve(tc, sb, graphs, !sb->body.wide && string_needs_wide(tc, s));
+        });
+    });
+    chunk = &(sb->body.chunks[sb->body.num_chunks - 1]);
+    if (s->body.storage_type == MVM_STRING_STRAND) {
+        MVMuint16 i;
+        for (i = 0; i < s->body.num_strands; i++) {
+            MVMStringStrand *strand = &(s->body.storage.strands[i]);
+            MVMuint32 r;
+            for (r = 0; r <= strand->repetitions; r++)
+                copy_graphemes(tc, chunk, strand->blob_string, strand->start, strand->end);
+        }
+    }
+    else {
+        copy_graphemes(tc, chunk, s, 0, graphs);
+    }
+    sb->body.num_graphs    += graphs;
+    sb->body.last_grapheme  = MVM_string_get_grapheme_at_nocheck(tc, s, graphs - 1);
+    sb->body.last_result    = NULL;
+}
+
+/* Appends a string to a string builder. */
+void MVM_string_builder_append(MVMThreadContext *tc, MVMObject *builder, MVMString *s) {
+    MVMStringBuilder *sb = ensure_builder(tc, builder, "strbuilderappend");
+    MVM_string_check_arg(tc, s, "strbuilderappend");
+    append_string(tc, sb, s);
+}
+
+/* Appends a codepoint to a string builder. Codepoints that are already a
+ * grapheme by themselves, and that do not combine with what went before,
+ * are written directly; anything else goes through the string path. */
+void MVM_string_builder_append_codepoint(MVMThreadContext *tc, MVMObject *builder, MVMint64 cp) {
+    MVMStringBuilder *sb = ensure_builder(tc, builder, "strbuilderappendcp");
+    if (cp >= 0 && cp < MVM_NORMALIZE_FIRST_SIG_NFC && (sb->body.num_graphs == 0 ||
+            MVM_nfg_is_concat_stable_graphemes(tc, sb->body.last_grapheme, (MVMGrapheme32)cp))) {
+        MVMStringBuilderChunk *chunk;
+        MVMROOT(tc, sb, {
+            reserve(tc, sb, 1, !can_fit_into_8bit((MVMGrapheme32)cp));
+        });
+        chunk = &(sb->body.chunks[sb->body.num_chunks - 1]);
+        if (chunk->blob_string->body.storage_type == MVM_STRING_GRAPHEME_32)
+            chunk->blob_string->body.storage.blob_32[chunk->end] = (MVMGrapheme32)cp;
+        else
+            chunk->blob_string->body.storage.blob_8[chunk->end] = (MVMGrapheme8)cp;
+        chunk->end++;
+        sb->body.num_graphs++;
+        sb->body.last_grapheme = (MVMGrapheme32)cp;
+        sb->body.last_result   = NULL;
+    }
+    else {
+        MVMROOT(tc, sb, {
+            MVMString *s = MVM_string_chr(tc, cp);
+            append_string(tc, sb, s);
+        });
+    }
+}
+
+/* Produces a flat string of everything in the builder. The builder then
+ * refers to that string, so asking again without appending is cheap. */
+MVMString * MVM_string_builder_to_str(MVMThreadContext *tc, MVMObject *builder) {
+    MVMStringBuilder      *sb = ensure_builder(tc, builder, "strbuildertostr");
+    MVMStringBuilderChunk  flat;
+    MVMString             *result;
+    MVMuint16              i;
+    if (sb->body.num_graphs == 0)
+        return tc->instance->str_consts.empty;
+
+    /* If everything is in one chunk that is full, we can hand that out. */
+    if (sb->body.num_chunks == 1) {
+        MVMStringBuilderChunk *chunk = &(sb->body.chunks[0]);
+        if (chunk->start == 0 && chunk->end == chunk->blob_string->body.num_graphs)
+            return chunk->blob_string;
+    }
+
+    /* Otherwise, flatten. */
+    MVMROOT(tc, sb, {
+        result = (MVMString *)MVM_repr_alloc_init(tc, tc->instance->VMString);
+    });
+    if (sb->body.wide) {
+        result->body.storage_type    = MVM_STRING_GRAPHEME_32;
+        result->body.storage.blob_32 = MVM_malloc(sb->body.num_graphs * sizeof(MVMGrapheme32));
+    }
+    else {
+        result->body.storage_type    = MVM_STRING_GRAPHEME_8;
+        result->body.storage.blob_8  = MVM_malloc(sb->body.num_graphs * sizeof(MVMGrapheme8));
+    }
+    flat.blob_string = result;
+    flat.start       = 0;
+    flat.end         = 0;
+    flat.capacity    = sb->body.num_graphs;
+    for (i = 0; i < sb->body.num_chunks; i++) {
+        MVMStringBuilderChunk *chunk = &(sb->body.chunks[i]);
+        copy_graphemes(tc, &flat, chunk->blob_string, chunk->start, chunk->end);
+    }
+    result->body.num_graphs = flat.end;
+    sb->body.num_chunks = 0;
+    add_chunk(tc, sb, result, 0, flat.end, 0);
+    return result;
+}
+
+/* Implements a concatenation a ~ b that spesh found to be accumulating in a
+ * loop, using a builder that spesh created on the way into the loop. When a
+ * is what we produced last time, we append to the builder in place;
+ * otherwise, we start the builder over from a. If the loop was entered by
+ * OSR, there is no builder, and we just concatenate. */
+MVMString * MVM_string_builder_concat_accum(MVMThreadContext *tc, MVMString *a, MVMString *b,
+        MVMObject *builder) {
+    MVMStringBuilder *sb;
+    MVMString        *result;
+    MVM_string_check_arg(tc, a, "concatenate");
+    MVM_string_check_arg(tc, b, "concatenate");
+
+    if (!builder)
+        return MVM_string_concatenate(tc, a, b);
+    sb = (MVMStringBuilder *)builder;
+
+    MVMROOT(tc, sb, {
+        MVMROOT(tc, b, {
+            if (sb->body.last_result != a)
+                reset(tc, sb, a);
+            append_string(tc, sb, b);
+        });
+        result = to_strand_string(tc, sb);
+    });
+    MVM_ASSIGN_REF(tc, &(sb->common.header), sb->body.last_result, result);
+    return result;
+}
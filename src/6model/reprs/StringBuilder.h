@@ -0,0 +1,54 @@
+/* Representation used for a VM-provided string builder. Appended graphemes
+ * are written into a list of chunks, each of which is a flat string that we
+ * own. A chunk's string has its full capacity as its length from the start,
+ * and only the unused part past the chunk's end is ever written. Strings
+ * produced from the builder are strands over the used parts of chunks, so
+ * they never see a write, and the builder can carry on appending after
+ * producing one without copying anything. Each new chunk is at least twice
+ * the size of the one before, so appends are amortized O(1) and there are
+ * few enough chunks to form a strand string over. */
+
+/* The minimum number of graphemes in a newly allocated chunk. */
+#define MVM_STRING_BUILDER_MIN_CHUNK 32
+
+/* A chunk of a string builder. A chunk with zero capacity will never be
+ * written to, since it refers to a part of a string that is not ours. */
+struct MVMStringBuilderChunk {
+    MVMString      *blob_string;
+    MVMStringIndex  start;
+    MVMStringIndex  end;
+    MVMStringIndex  capacity;
+};
+
+struct MVMStringBuilderBody {
+    /* The chunks, and how many are used and allocated. */
+    MVMStringBuilderChunk *chunks;
+    MVMuint16 num_chunks;
+    MVMuint16 alloc_chunks;
+
+    /* Whether we need 32-bit chunks from now on, since a grapheme that does
+     * not fit in 8 bits was appended. */
+    MVMuint16 wide;
+
+    /* The total number of graphemes, and the last of them. */
+    MVMuint32     num_graphs;
+    MVMGrapheme32 last_grapheme;
+
+    /* The string last produced by concatenation through the builder, used
+     * to spot when we are asked to continue on from it. */
+    MVMString *last_result;
+};
+struct MVMStringBuilder {
+    MVMObject common;
+    MVMStringBuilderBody body;
+};
+
+/* Function for REPR setup. */
+const MVMREPROps * MVMStringBuilder_initialize(MVMThreadContext *tc);
+
+/* Operations on a StringBuilder object. */
+void MVM_string_builder_append(MVMThreadContext *tc, MVMObject *builder, MVMString *s);
+void MVM_string_builder_append_codepoint(MVMThreadContext *tc, MVMObject *builder, MVMint64 cp);
+MVMString * MVM_string_builder_to_str(MVMThreadContext *tc, MVMObject *builder);
+MVMString * MVM_string_builder_concat_accum(MVMThreadContext *tc, MVMString *a, MVMString *b,
+    MVMObject *builder);
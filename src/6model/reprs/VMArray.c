@@ -17,6 +17,106 @@ static void exit_single_user(MVMThreadContext *tc, MVMArrayBody *arr) {
 #endif
 }
 
+/* Gets the address of an object or string slot, by its position counting
+ * from the first slot (so with start already added). */
+MVM_STATIC_INLINE void ** ref_slot(MVMArrayBody *body, MVMuint64 pos) {
+    if (body->chunks)
+        return (void **)body->chunks[pos >> MVM_ARRAY_CHUNK_BITS]
+            + (pos & (MVM_ARRAY_CHUNK_SIZE - 1));
+    return (void **)body->slots.any + pos;
+}
+#define OBJ_SLOT(body, pos) (*(MVMObject **)ref_slot((body), (pos)))
+#define STR_SLOT(body, pos) (*(MVMString **)ref_slot((body), (pos)))
+
+/* Moves count slots from one position to another, like memmove. */
+static void move_slots(MVMArrayBody *body, MVMuint64 to, MVMuint64 from, MVMuint64 count,
+        size_t elem_size) {
+    if (body->chunks) {
+        MVMuint64 i;
+        if (to < from)
+            for (i = 0; i < count; i++)
+                *ref_slot(body, to + i) = *ref_slot(body, from + i);
+        else
+            for (i = count; i > 0; i--)
+                *ref_slot(body, to + i - 1) = *ref_slot(body, from + i - 1);
+    }
+    else {
+        memmove((char *)body->slots.any + to * elem_size,
+            (char *)body->slots.any + from * elem_size,
+            count * elem_size);
+    }
+}
+
+/* Makes sure there is room for count chunks in the chunks array. */
+static void ensure_chunks_alloc(MVMArrayBody *body, MVMuint64 count) {
+    if (count > body->alloc_chunks) {
+        MVMuint64 alloc = body->alloc_chunks * 2;
+        if (alloc < count)
+            alloc = count;
+        body->chunks       = MVM_realloc(body->chunks, alloc * sizeof(void *));
+        body->alloc_chunks = alloc;
+    }
+}
+
+/* Switches an array of objects or strings over to chunked storage, leaving
+ * the elements starting at the first slot. */
+static void make_chunked(MVMArrayBody *body) {
+    MVMuint64 elems      = body->elems;
+    MVMuint64 num_chunks = (elems + MVM_ARRAY_CHUNK_SIZE - 1) >> MVM_ARRAY_CHUNK_BITS;
+    void    **slots      = (void **)body->slots.any + body->start;
+    MVMuint64 i;
+    if (num_chunks == 0)
+        num_chunks = 1;
+    body->chunks       = NULL;
+    body->alloc_chunks = 0;
+    ensure_chunks_alloc(body, num_chunks * 2);
+    for (i = 0; i < num_chunks; i++) {
+        MVMuint64 offset = i << MVM_ARRAY_CHUNK_BITS;
+        MVMuint64 to_copy = elems - offset < MVM_ARRAY_CHUNK_SIZE
+            ? elems - offset
+            : MVM_ARRAY_CHUNK_SIZE;
+        body->chunks[i] = MVM_calloc(MVM_ARRAY_CHUNK_SIZE, sizeof(void *));
+        memcpy(body->chunks[i], slots + offset, to_copy * sizeof(void *));
+    }
+    MVM_free(body->slots.any);
+    body->slots.any = NULL;
+    body->start     = 0;
+    body->ssize     = num_chunks << MVM_ARRAY_CHUNK_BITS;
+}
+
+/* Resizes a chunked array. Chunks we have shifted past are reused before
+ * new ones are allocated, so an array used as a queue does not keep on
+ * growing. */
+static void set_size_chunked(MVMArrayBody *body, MVMuint64 n) {
+    MVMuint64 start = body->start;
+    MVMuint64 ssize = body->ssize;
+    if (start + n > ssize) {
+        MVMuint64 num_chunks = ssize >> MVM_ARRAY_CHUNK_BITS;
+        MVMuint64 spare      = start >> MVM_ARRAY_CHUNK_BITS;
+        MVMuint64 needed;
+        if (spare > 0) {
+            void    **recycled = MVM_malloc(spare * sizeof(void *));
+            MVMuint64 i;
+            memcpy(recycled, body->chunks, spare * sizeof(void *));
+            memmove(body->chunks, body->chunks + spare,
+                (num_chunks - spare) * sizeof(void *));
+            for (i = 0; i < spare; i++) {
+                memset(recycled[i], 0, MVM_ARRAY_CHUNK_SIZE * sizeof(void *));
+                body->chunks[num_chunks - spare + i] = recycled[i];
+            }
+            MVM_free(recycled);
+            start -= spare << MVM_ARRAY_CHUNK_BITS;
+            body->start = start;
+        }
+        needed = (start + n + MVM_ARRAY_CHUNK_SIZE - 1) >> MVM_ARRAY_CHUNK_BITS;
+        ensure_chunks_alloc(body, needed);
+        while (num_chunks < needed)
+            body->chunks[num_chunks++] = MVM_calloc(MVM_ARRAY_CHUNK_SIZE, sizeof(void *));
+        body->ssize = num_chunks << MVM_ARRAY_CHUNK_BITS;
+    }
+    body->elems = n;
+}
+
 /* Creates a new type object of this representation, and associates it with
  * the given HOW. */
 static MVMObject * type_object_for(MVMThreadContext *tc, MVMObject *HOW) {
@@ -45,6 +145,17 @@ static void copy_to(MVMThreadContext *tc, MVMSTable *st, void *src, MVMObject *d
     MVMArrayREPRData *repr_data = (MVMArrayREPRData *)st->REPR_data;
     MVMArrayBody     *src_body  = (MVMArrayBody *)src;
     MVMArrayBody     *dest_body = (MVMArrayBody *)dest;
+    if (src_body->chunks) {
+        MVMuint64 i;
+        dest_body->elems = 0;
+        dest_body->start = 0;
+        dest_body->ssize = 0;
+        make_chunked(dest_body);
+        set_size_chunked(dest_body, src_body->elems);
+        for (i = 0; i < src_body->elems; i++)
+            *ref_slot(dest_body, i) = *ref_slot(src_body, src_body->start + i);
+        return;
+    }
     dest_body->elems = src_body->elems;
     dest_body->ssize = src_body->elems;
     dest_body->start = 0;
@@ -67,6 +178,13 @@ static void gc_mark(MVMThreadContext *tc, MVMSTable *st, void *data, MVMGCWorkli
     MVMuint64         elems     = body->elems;
     MVMuint64         start     = body->start;
     MVMuint64         i         = 0;
+    if (body->chunks) {
+        while (i < elems) {
+            MVM_gc_worklist_add(tc, worklist, ref_slot(body, start + i));
+            i++;
+        }
+        return;
+    }
     switch (repr_data->slot_type) {
         case MVM_ARRAY_OBJ: {
             MVMObject **slots = body->slots.o;
@@ -92,6 +210,13 @@ static void gc_mark(MVMThreadContext *tc, MVMSTable *st, void *data, MVMGCWorkli
 /* Called by the VM in order to free memory associated with this object. */
 static void gc_free(MVMThreadContext *tc, MVMObject *obj) {
     MVMArray *arr = (MVMArray *)obj;
+    if (arr->body.chunks) {
+        MVMuint64 num_chunks = arr->body.ssize >> MVM_ARRAY_CHUNK_BITS;
+        MVMuint64 i;
+        for (i = 0; i < num_chunks; i++)
+            MVM_free(arr->body.chunks[i]);
+        MVM_free(arr->body.chunks);
+    }
     MVM_free(arr->body.slots.any);
 }
 
@@ -144,7 +269,7 @@ static void at_pos(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *d
                 value->o = tc->instance->VMNull;
             }
             else {
-                MVMObject *found = body->slots.o[body->start + index];
+                MVMObject *found = OBJ_SLOT(body, body->start + index);
                 value->o = found ? found : tc->instance->VMNull;
             }
             break;
@@ -154,7 +279,7 @@ static void at_pos(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *d
             if (index >= body->elems)
                 value->s = NULL;
             else
-                value->s = body->slots.s[body->start + index];
+                value->s = STR_SLOT(body, body->start + index);
             break;
         case MVM_ARRAY_I64:
             if (kind != MVM_reg_int64)
@@ -246,11 +371,11 @@ static MVMuint64 zero_slots(MVMThreadContext *tc, MVMArrayBody *body,
     switch (slot_type) {
         case MVM_ARRAY_OBJ:
             while (elems < ssize)
-                body->slots.o[elems++] = NULL;
+                OBJ_SLOT(body, elems++) = NULL;
             break;
         case MVM_ARRAY_STR:
             while (elems < ssize)
-                body->slots.s[elems++] = NULL;
+                STR_SLOT(body, elems++) = NULL;
             break;
         case MVM_ARRAY_I64:
             while (elems < ssize)
@@ -298,6 +423,13 @@ static MVMuint64 zero_slots(MVMThreadContext *tc, MVMArrayBody *body,
     return elems;
 }
 
+/* Whether growing a contiguous array to n elements should switch it over to
+ * chunked storage. */
+static MVMint32 should_chunk(MVMArrayBody *body, MVMuint64 n, MVMArrayREPRData *repr_data) {
+    return !body->chunks && n > body->ssize && n > MVM_ARRAY_CHUNK_THRESHOLD
+        && (repr_data->slot_type == MVM_ARRAY_OBJ || repr_data->slot_type == MVM_ARRAY_STR);
+}
+
 static void set_size_internal(MVMThreadContext *tc, MVMArrayBody *body, MVMuint64 n, MVMArrayREPRData *repr_data) {
     MVMuint64   elems = body->elems;
     MVMuint64   start = body->start;
@@ -311,6 +443,21 @@ static void set_size_internal(MVMThreadContext *tc, MVMArrayBody *body, MVMuint6
     if (n == elems)
         return;
 
+    if (body->chunks) {
+        set_size_chunked(body, n);
+        if (n > elems)
+            zero_slots(tc, body, body->start + elems, body->start + n, repr_data->slot_type);
+        return;
+    }
+
+    /* Rather than growing big arrays of references yet further, switch them
+     * to chunks. */
+    if (should_chunk(body, n, repr_data)) {
+        make_chunked(body);
+        set_size_chunked(body, n);
+        return;
+    }
+
     /* if there aren't enough slots at the end, shift off empty slots
      * from the beginning first */
     if (start > 0 && n + start > ssize) {
@@ -377,12 +524,12 @@ static void bind_pos(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void
         case MVM_ARRAY_OBJ:
             if (kind != MVM_reg_obj)
                 MVM_exception_throw_adhoc(tc, "MVMArray: bindpos expected object register");
-            MVM_ASSIGN_REF(tc, &(root->header), body->slots.o[body->start + index], value.o);
+            MVM_ASSIGN_REF(tc, &(root->header), OBJ_SLOT(body, body->start + index), value.o);
             break;
         case MVM_ARRAY_STR:
             if (kind != MVM_reg_str)
                 MVM_exception_throw_adhoc(tc, "MVMArray: bindpos expected string register");
-            MVM_ASSIGN_REF(tc, &(root->header), body->slots.s[body->start + index], value.s);
+            MVM_ASSIGN_REF(tc, &(root->header), STR_SLOT(body, body->start + index), value.s);
             break;
         case MVM_ARRAY_I64:
             if (kind != MVM_reg_int64)
@@ -462,12 +609,12 @@ static void push(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *dat
         case MVM_ARRAY_OBJ:
             if (kind != MVM_reg_obj)
                 MVM_exception_throw_adhoc(tc, "MVMArray: push expected object register");
-            MVM_ASSIGN_REF(tc, &(root->header), body->slots.o[body->start + body->elems - 1], value.o);
+            MVM_ASSIGN_REF(tc, &(root->header), OBJ_SLOT(body, body->start + body->elems - 1), value.o);
             break;
         case MVM_ARRAY_STR:
             if (kind != MVM_reg_str)
                 MVM_exception_throw_adhoc(tc, "MVMArray: push expected string register");
-            MVM_ASSIGN_REF(tc, &(root->header), body->slots.s[body->start + body->elems - 1], value.s);
+            MVM_ASSIGN_REF(tc, &(root->header), STR_SLOT(body, body->start + body->elems - 1), value.s);
             break;
         case MVM_ARRAY_I64:
             if (kind != MVM_reg_int64)
@@ -540,12 +687,12 @@ static void pop(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data
         case MVM_ARRAY_OBJ:
             if (kind != MVM_reg_obj)
                 MVM_exception_throw_adhoc(tc, "MVMArray: pop expected object register");
-            value->o = body->slots.o[slot];
+            value->o = OBJ_SLOT(body, slot);
             break;
         case MVM_ARRAY_STR:
             if (kind != MVM_reg_str)
                 MVM_exception_throw_adhoc(tc, "MVMArray: pop expected string register");
-            value->s = body->slots.s[slot];
+            value->s = STR_SLOT(body, slot);
             break;
         case MVM_ARRAY_I64:
             if (kind != MVM_reg_int64)
@@ -611,7 +758,18 @@ static void unshift(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *
     /* If we don't have room at the beginning of the slots,
      * make some room (8 slots) for unshifting */
     enter_single_user(tc, body);
-    if (body->start < 1) {
+    if (body->start < 1 && should_chunk(body, body->elems + 8, repr_data))
+        make_chunked(body);
+    if (body->start < 1 && body->chunks) {
+        /* Add a chunk at the front; only the chunks array gets moved. */
+        MVMuint64 num_chunks = body->ssize >> MVM_ARRAY_CHUNK_BITS;
+        ensure_chunks_alloc(body, num_chunks + 1);
+        memmove(body->chunks + 1, body->chunks, num_chunks * sizeof(void *));
+        body->chunks[0] = MVM_calloc(MVM_ARRAY_CHUNK_SIZE, sizeof(void *));
+        body->start     = MVM_ARRAY_CHUNK_SIZE;
+        body->ssize    += MVM_ARRAY_CHUNK_SIZE;
+    }
+    else if (body->start < 1) {
         MVMuint64 n = 8;
         MVMuint64 elems = body->elems;
 
@@ -636,12 +794,12 @@ static void unshift(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *
         case MVM_ARRAY_OBJ:
             if (kind != MVM_reg_obj)
                 MVM_exception_throw_adhoc(tc, "MVMArray: unshift expected object register");
-            MVM_ASSIGN_REF(tc, &(root->header), body->slots.o[body->start], value.o);
+            MVM_ASSIGN_REF(tc, &(root->header), OBJ_SLOT(body, body->start), value.o);
             break;
         case MVM_ARRAY_STR:
             if (kind != MVM_reg_str)
                 MVM_exception_throw_adhoc(tc, "MVMArray: unshift expected string register");
-            MVM_ASSIGN_REF(tc, &(root->header), body->slots.s[body->start], value.s);
+            MVM_ASSIGN_REF(tc, &(root->header), STR_SLOT(body, body->start), value.s);
             break;
         case MVM_ARRAY_I64:
             if (kind != MVM_reg_int64)
@@ -713,12 +871,12 @@ static void shift(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *da
         case MVM_ARRAY_OBJ:
             if (kind != MVM_reg_obj)
                 MVM_exception_throw_adhoc(tc, "MVMArray: shift expected object register");
-            value->o = body->slots.o[body->start];
+            value->o = OBJ_SLOT(body, body->start);
             break;
         case MVM_ARRAY_STR:
             if (kind != MVM_reg_str)
                 MVM_exception_throw_adhoc(tc, "MVMArray: shift expected string register");
-            value->s = body->slots.s[body->start];
+            value->s = STR_SLOT(body, body->start);
             break;
         case MVM_ARRAY_I64:
             if (kind != MVM_reg_int64)
@@ -839,10 +997,8 @@ static void asplice(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *
     else if (tail > 0 && count > elems1) {
         /* We're shrinking the array, so first move the tail left */
         start = body->start;
-        memmove(
-            (char *)body->slots.any + (start + offset + elems1) * repr_data->elem_size,
-            (char *)body->slots.any + (start + offset + count) * repr_data->elem_size,
-            tail * repr_data->elem_size);
+        move_slots(body, start + offset + elems1, start + offset + count, tail,
+            repr_data->elem_size);
     }
 
     /* now resize the array */
@@ -851,10 +1007,8 @@ static void asplice(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *
     start = body->start;
     if (tail > 0 && count < elems1) {
         /* The array grew, so move the tail to the right */
-        memmove(
-            (char *)body->slots.any + (start + offset + elems1) * repr_data->elem_size,
-            (char *)body->slots.any + (start + offset + count) * repr_data->elem_size,
-            tail * repr_data->elem_size);
+        move_slots(body, start + offset + elems1, start + offset + count, tail,
+            repr_data->elem_size);
     }
     exit_single_user(tc, body);
 
@@ -1171,10 +1325,10 @@ static void serialize(MVMThreadContext *tc, MVMSTable *st, void *data, MVMSerial
     for (i = 0; i < body->elems; i++) {
         switch (repr_data->slot_type) {
             case MVM_ARRAY_OBJ:
-                MVM_serialization_write_ref(tc, writer, body->slots.o[body->start + i]);
+                MVM_serialization_write_ref(tc, writer, OBJ_SLOT(body, body->start + i));
                 break;
             case MVM_ARRAY_STR:
-                MVM_serialization_write_str(tc, writer, body->slots.s[body->start + i]);
+                MVM_serialization_write_str(tc, writer, STR_SLOT(body, body->start + i));
                 break;
             case MVM_ARRAY_I64:
                 MVM_serialization_write_int(tc, writer, (MVMint64)body->slots.i64[body->start + i]);
@@ -1235,7 +1389,7 @@ static void spesh(MVMThreadContext *tc, MVMSTable *st, MVMSpeshGraph *g, MVMSpes
 static MVMuint64 unmanaged_size(MVMThreadContext *tc, MVMSTable *st, void *data) {
     MVMArrayREPRData *repr_data = (MVMArrayREPRData *) st->REPR_data;
     MVMArrayBody     *body      = (MVMArrayBody *)data;
-    return body->ssize * repr_data->elem_size;
+    return body->ssize * repr_data->elem_size + body->alloc_chunks * sizeof(void *);
 }
 
 static void describe_refs (MVMThreadContext *tc, MVMHeapSnapshotState *ss, MVMSTable *st, void *data) {
@@ -1245,6 +1399,14 @@ static void describe_refs (MVMThreadContext *tc, MVMHeapSnapshotState *ss, MVMST
     MVMuint64         start     = body->start;
     MVMuint64         i         = 0;
 
+    if (body->chunks) {
+        while (i < elems) {
+            MVM_profile_heap_add_collectable_rel_idx(tc, ss,
+                *(MVMCollectable **)ref_slot(body, start + i), i);
+            i++;
+        }
+        return;
+    }
     switch (repr_data->slot_type) {
         case MVM_ARRAY_OBJ: {
             MVMObject **slots = body->slots.o;
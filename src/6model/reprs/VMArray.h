@@ -1,8 +1,16 @@
 /* Concurrent use of a VMArray is erroneous. This debugging option will
  * catch bad usages. (Eventually, we will refactor VMArray to not have
- * this issue.) */
+ * this issue.) Arrays shared between threads should use ConcArray. */
 #define MVM_ARRAY_CONC_DEBUG 0
 
+/* Arrays of objects or strings that grow beyond this many slots switch to
+ * chunked storage, so growing no longer copies everything into a bigger
+ * buffer, and needs no more than one chunk of spare memory to do so. Native
+ * arrays always stay contiguous, since they are handed to C code. */
+#define MVM_ARRAY_CHUNK_THRESHOLD (1 << 20)
+#define MVM_ARRAY_CHUNK_BITS      16
+#define MVM_ARRAY_CHUNK_SIZE      (1 << MVM_ARRAY_CHUNK_BITS)
+
 /* Representation used by VM-level arrays. Adopted from QRPA work by
  * Patrick Michaud. */
 struct MVMArrayBody {
@@ -32,6 +40,12 @@ struct MVMArrayBody {
         void       *any;
     } slots;
 
+    /* If the array is chunked, the chunks of MVM_ARRAY_CHUNK_SIZE slots in
+     * order, with slots unused and ssize the number of chunks times their
+     * size; otherwise NULL. Also the size of the chunks array. */
+    void      **chunks;
+    MVMuint64   alloc_chunks;
+
 #if MVM_ARRAY_CONC_DEBUG
     AO_t in_use;
 #endif 
@@ -1498,8 +1498,10 @@ static void fail_deserialize(MVMThreadContext *tc, MVMSerializationReader *reade
 /* Reads the item from the string heap at the specified index. */
 static MVMString * read_string_from_heap(MVMThreadContext *tc, MVMSerializationReader *reader, MVMuint32 idx) {
     if (reader->root.string_heap) {
-        if (idx < MVM_repr_elems(tc, reader->root.string_heap))
-            return MVM_repr_at_pos_s(tc, reader->root.string_heap, idx);
+        if (idx < MVM_repr_elems(tc, reader->root.string_heap)) {
+            MVMString *s = MVM_repr_at_pos_s(tc, reader->root.string_heap, idx);
+            return s ? MVM_string_intern(tc, s) : NULL;
+        }
         else
             fail_deserialize(tc, reader,
                 "Attempt to read past end of string heap (index %d)", idx);
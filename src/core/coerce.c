@@ -182,19 +182,16 @@ MVMString * MVM_coerce_n_s(MVMThreadContext *tc, MVMnum64 n) {
         return MVM_string_ascii_decode_nt(tc, tc->instance->VMString, "NaN");
     }
     else {
-        char buf[64];
-        int i;
-        if (snprintf(buf, 64, "%.15g", n) < 0)
-            MVM_exception_throw_adhoc(tc, "Could not stringify number");
-        if (strstr(buf, ".")) {
-            MVMint64 is_not_scientific = !strstr(buf, "e");
-            i = strlen(buf);
-            while (i > 1 && ((buf[--i] == '0'  && is_not_scientific) || buf[i] == ' '))
-                buf[i] = '\0';
-            if (buf[i] == '.')
-                buf[i] = '\0';
-        }
-        return MVM_string_ascii_decode(tc, tc->instance->VMString, buf, strlen(buf));
+        /* Format straight into the storage of an 8-bit string. The storage
+         * may be a few bytes longer than the result, which is cheaper than
+         * copying it. */
+        MVMGrapheme8 *blob   = MVM_malloc(MVM_NUM_SHORTEST_BUFFER_SIZE);
+        size_t        len    = MVM_num_format_shortest(n, (char *)blob);
+        MVMString    *result = (MVMString *)MVM_repr_alloc_init(tc, tc->instance->VMString);
+        result->body.storage_type   = MVM_STRING_GRAPHEME_8;
+        result->body.storage.blob_8 = blob;
+        result->body.num_graphs     = len;
+        return result;
     }
 }
 
@@ -248,9 +245,54 @@ void MVM_coerce_smart_stringify(MVMThreadContext *tc, MVMObject *obj, MVMRegiste
     }
 }
 
+/* Parses an integer from a string in ASCII or 8-bit storage the same way
+ * strtoll does in base 10, without encoding the string first. Returns 0 if
+ * the string holds non-ASCII chars, which the caller should then handle. */
+static MVMint32 parse_int_8bit(MVMThreadContext *tc, MVMString *s, MVMint64 *result) {
+    const MVMuint8 *p, *end, *rest;
+    MVMuint64 value    = 0;
+    MVMuint64 limit;
+    MVMint32  negative = 0;
+    MVMint32  overflow = 0;
+
+    if (s->body.storage_type == MVM_STRING_GRAPHEME_ASCII)
+        p = (const MVMuint8 *)s->body.storage.blob_ascii;
+    else if (s->body.storage_type == MVM_STRING_GRAPHEME_8)
+        p = (const MVMuint8 *)s->body.storage.blob_8;
+    else
+        return 0;
+    end = p + s->body.num_graphs;
+    for (rest = p; rest < end; rest++)
+        if (*rest >= 0x80)
+            return 0;
+
+    while (p < end && (*p == ' ' || (*p >= 9 && *p <= 13)))
+        p++;
+    if (p < end && (*p == '-' || *p == '+'))
+        negative = *p++ == '-';
+    limit = negative ? (MVMuint64)9223372036854775807LL + 1 : 9223372036854775807ULL;
+    while (p < end && *p >= '0' && *p <= '9') {
+        MVMuint64 digit = *p++ - '0';
+        if (value > (limit - digit) / 10)
+            overflow = 1;
+        else
+            value = value * 10 + digit;
+    }
+
+    if (overflow)
+        *result = negative ? (-9223372036854775807LL - 1) : 9223372036854775807LL;
+    else
+        *result = negative ? (MVMint64)(0 - value) : (MVMint64)value;
+    return 1;
+}
+
 MVMint64 MVM_coerce_s_i(MVMThreadContext *tc, MVMString *s) {
-    char     *enc = MVM_string_ascii_encode(tc, s, NULL, 0);
-    MVMint64  i   = strtoll(enc, NULL, 10);
+    char     *enc;
+    MVMint64  i;
+    if (s && parse_int_8bit(tc, s, &i))
+        return i;
+    enc = MVM_string_ascii_encode(tc, s, NULL, 0);
+    i   = strtoll(enc, NULL, 10);
     MVM_free(enc);
     return i;
 }
@@ -419,11 +461,14 @@ void MVM_box_int(MVMThreadContext *tc, MVMint64 value, MVMObject *type,
 
 void MVM_box_num(MVMThreadContext *tc, MVMnum64 value, MVMObject *type,
                  MVMRegister * dst) {
-    MVMObject *box = REPR(type)->allocate(tc, STABLE(type));
-    if (REPR(box)->initialize)
-        REPR(box)->initialize(tc, STABLE(box), box, OBJECT_BODY(box));
-    REPR(box)->box_funcs.set_num(tc, STABLE(box), box,
-                                 OBJECT_BODY(box), value);
+    MVMObject *box = MVM_numcache_get(tc, type, value);
+    if (box == 0) {
+        box = REPR(type)->allocate(tc, STABLE(type));
+        if (REPR(box)->initialize)
+            REPR(box)->initialize(tc, STABLE(box), box, OBJECT_BODY(box));
+        REPR(box)->box_funcs.set_num(tc, STABLE(box), box,
+                                     OBJECT_BODY(box), value);
+    }
     dst->o = box;
 
 }
@@ -18,6 +18,8 @@ MVMHLLConfig *MVM_hll_get_config_for(MVMThreadContext *tc, MVMString *name) {
         entry->int_box_type = tc->instance->boot_types.BOOTInt;
         entry->num_box_type = tc->instance->boot_types.BOOTNum;
         entry->str_box_type = tc->instance->boot_types.BOOTStr;
+        entry->int_cache_min = MVM_INTCACHE_DEFAULT_MIN;
+        entry->int_cache_max = MVM_INTCACHE_DEFAULT_MAX;
         entry->slurpy_array_type = tc->instance->boot_types.BOOTArray;
         entry->slurpy_hash_type = tc->instance->boot_types.BOOTHash;
         entry->array_iterator_type = tc->instance->boot_types.BOOTIter;
@@ -84,6 +86,11 @@ MVMHLLConfig *MVM_hll_get_config_for(MVMThreadContext *tc, MVMString *name) {
         (config)->member = val; \
     }\
 } while (0)
+#define check_config_key_int(tc, hash, name, member, config) do { \
+    MVMString *key = MVM_string_utf8_decode((tc), (tc)->instance->VMString, (name), strlen((name))); \
+    MVMObject *val = MVM_repr_at_key_o((tc), (hash), key); \
+    if (!MVM_is_null(tc, val)) (config)->member = MVM_repr_get_int((tc), val); \
+} while (0)
 
 MVMObject * MVM_hll_set_config(MVMThreadContext *tc, MVMString *name, MVMObject *config_hash) {
     MVMHLLConfig *config;
@@ -100,6 +107,8 @@ MVMObject * MVM_hll_set_config(MVMThreadContext *tc, MVMString *name, MVMObject
             check_config_key(tc, config_hash, "int_box", int_box_type, config);
             check_config_key(tc, config_hash, "num_box", num_box_type, config);
             check_config_key(tc, config_hash, "str_box", str_box_type, config);
+            check_config_key_int(tc, config_hash, "int_cache_min", int_cache_min, config);
+            check_config_key_int(tc, config_hash, "int_cache_max", int_cache_max, config);
             check_config_key(tc, config_hash, "slurpy_array", slurpy_array_type, config);
             check_config_key(tc, config_hash, "slurpy_hash", slurpy_hash_type, config);
             check_config_key(tc, config_hash, "array_iter", array_iterator_type, config);
@@ -142,7 +151,8 @@ MVMObject * MVM_hll_set_config(MVMThreadContext *tc, MVMString *name, MVMObject
                 config, MVM_STORAGE_SPEC_BP_STR, MVM_NATIVEREF_MULTIDIM);
         });
 
-    MVM_intcache_for(tc, config->int_box_type);
+    MVM_intcache_for_range(tc, config->int_box_type, config->int_cache_min, config->int_cache_max);
+    MVM_numcache_for(tc, config->num_box_type);
 
     return config_hash;
 }
@@ -6,6 +6,10 @@ struct MVMHLLConfig {
     MVMObject *num_box_type;
     MVMObject *str_box_type;
 
+    /* The range of integers to keep boxed in int_box_type. */
+    MVMint64 int_cache_min;
+    MVMint64 int_cache_max;
+
     /* The type to use for slurpy arrays. */
     MVMObject *slurpy_array_type;
 
@@ -326,6 +326,10 @@ struct MVMInstance {
     MVMIntConstCache    *int_const_cache;
     uv_mutex_t mutex_int_const_cache;
 
+    /* Size in bits of the smaller operand from which big integers are
+     * multiplied by number theoretic transform (zero if never). */
+    MVMuint32 bigint_ntt_threshold;
+
     /* Multi-dispatch cache addition mutex (additions are relatively
      * rare, so little motivation to have it more fine-grained). */ 
     uv_mutex_t mutex_multi_cache_add;
@@ -374,6 +378,10 @@ struct MVMInstance {
     MVMObject *SpeshLog;
     MVMObject *StaticFrameSpesh;
 
+    /* StringBuilder type, used by spesh to make accumulating concatenation
+     * in loops linear. */
+    MVMObject *StringBuilder;
+
     /* Set of bootstrapping types. */
     MVMBootTypes boot_types;
 
@@ -406,6 +414,10 @@ struct MVMInstance {
     MVMObject          *compiler_registry;
     uv_mutex_t    mutex_compiler_registry;
 
+    /* Interned strings, keyed on their content, in separately locked
+     * stripes. */
+    MVMStringInternStripe *string_interns;
+
     /* Hash of filenames of compunits loaded from disk. */
     MVMLoadedCompUnitName *loaded_compunits;
     uv_mutex_t       mutex_loaded_compunits;
@@ -1,53 +1,160 @@
 #include "moar.h"
 
+/* The nums we keep boxed, which are the ones most often produced by code
+ * that is counting or accumulating. Zero means positive zero only. */
+static const MVMnum64 num_cache_values[MVM_NUMCACHE_VALUES] = { 0.0, 1.0, -1.0, 0.5, 2.0 };
+
 void MVM_intcache_for(MVMThreadContext *tc, MVMObject *type) {
+    MVM_intcache_for_range(tc, type, MVM_INTCACHE_DEFAULT_MIN, MVM_INTCACHE_DEFAULT_MAX);
+}
+
+/* Makes sure we have boxed integers from at least min to max for the type.
+ * If the type is already cached with a narrower range, the range grows;
+ * caches never shrink, so one HLL cannot take values from another. */
+void MVM_intcache_for_range(MVMThreadContext *tc, MVMObject *type, MVMint64 min, MVMint64 max) {
+    MVMIntConstCache      *cache = tc->instance->int_const_cache;
+    MVMIntConstCacheRange *old_range = NULL;
+    MVMIntConstCacheRange *range;
     int type_index;
     int right_slot = -1;
+    MVMint64 val;
+
+    if (max < min)
+        return;
+
     uv_mutex_lock(&tc->instance->mutex_int_const_cache);
-    for (type_index = 0; type_index < 4; type_index++) {
-        if (tc->instance->int_const_cache->types[type_index] == NULL) {
+    for (type_index = 0; type_index < MVM_INTCACHE_TYPES; type_index++) {
+        if (cache->types[type_index] == NULL) {
             right_slot = type_index;
             break;
         }
-        else if (tc->instance->int_const_cache->types[type_index] == type) {
-            uv_mutex_unlock(&tc->instance->mutex_int_const_cache);
-            return;
+        else if (cache->types[type_index] == type) {
+            old_range = cache->ranges[type_index];
+            if (old_range->min <= min && old_range->max >= max) {
+                uv_mutex_unlock(&tc->instance->mutex_int_const_cache);
+                return;
+            }
+            if (old_range->min < min)
+                min = old_range->min;
+            if (old_range->max > max)
+                max = old_range->max;
+            right_slot = type_index;
+            break;
         }
     }
+    if (right_slot != -1 && (MVMuint64)max - (MVMuint64)min >= MVM_INTCACHE_MAX_VALUES) {
+        uv_mutex_unlock(&tc->instance->mutex_int_const_cache);
+        MVM_exception_throw_adhoc(tc,
+            "Cannot cache more than %d boxed integers for a type", MVM_INTCACHE_MAX_VALUES);
+    }
     if (right_slot != -1) {
-        int val;
-        for (val = -1; val < 15; val++) {
-            MVMObject *obj;
-            obj = MVM_repr_alloc_init(tc, type);
-            MVM_repr_set_int(tc, obj, val);
-            tc->instance->int_const_cache->cache[type_index][val + 1] = obj;
+        /* Fill in the new range where the GC can see it, reusing any boxes
+         * we already have. */
+        range           = MVM_malloc(sizeof(MVMIntConstCacheRange));
+        range->min      = min;
+        range->max      = max;
+        range->boxes    = MVM_calloc(max - min + 1, sizeof(MVMObject *));
+        range->replaced = old_range;
+        cache->building = range;
+        for (val = min; val <= max; val++) {
+            if (old_range && val >= old_range->min && val <= old_range->max) {
+                range->boxes[val - min] = old_range->boxes[val - old_range->min];
+            }
+            else {
+                MVMObject *obj = MVM_repr_alloc_init(tc, type);
+                MVM_repr_set_int(tc, obj, val);
+                range->boxes[val - min] = obj;
+            }
+        }
+
+        /* Publish the range before the type, so a reader that finds the
+         * type always finds its boxes. */
+        MVM_barrier();
+        cache->ranges[right_slot] = range;
+        cache->building           = NULL;
+        if (!old_range) {
+            MVM_barrier();
+            cache->types[right_slot] = type;
             MVM_gc_root_add_permanent_desc(tc,
-                (MVMCollectable **)&tc->instance->int_const_cache->cache[type_index][val + 1],
-                "Boxed integer cache entry");
+                (MVMCollectable **)&cache->types[right_slot],
+                "Boxed integer cache type");
         }
-        tc->instance->int_const_cache->types[type_index] = type;
-        MVM_gc_root_add_permanent_desc(tc,
-            (MVMCollectable **)&tc->instance->int_const_cache->types[type_index],
-            "Boxed integer cache type");
     }
     uv_mutex_unlock(&tc->instance->mutex_int_const_cache);
 }
 
 MVMObject *MVM_intcache_get(MVMThreadContext *tc, MVMObject *type, MVMint64 value) {
+    MVMIntConstCache *cache = tc->instance->int_const_cache;
     int type_index;
-    int right_slot = -1;
 
-    if (value < -1 || value >= 15)
-        return NULL;
+    for (type_index = 0; type_index < MVM_INTCACHE_TYPES; type_index++) {
+        if (cache->types[type_index] == type) {
+            MVMIntConstCacheRange *range = cache->ranges[type_index];
+            if (value < range->min || value > range->max)
+                return NULL;
+            return range->boxes[value - range->min];
+        }
+    }
+    return NULL;
+}
 
-    for (type_index = 0; type_index < 4; type_index++) {
-        if (tc->instance->int_const_cache->types[type_index] == type) {
+void MVM_numcache_for(MVMThreadContext *tc, MVMObject *type) {
+    MVMIntConstCache *cache = tc->instance->int_const_cache;
+    int type_index;
+    int right_slot = -1;
+    uv_mutex_lock(&tc->instance->mutex_int_const_cache);
+    for (type_index = 0; type_index < MVM_INTCACHE_TYPES; type_index++) {
+        if (cache->num_types[type_index] == NULL) {
             right_slot = type_index;
             break;
         }
+        else if (cache->num_types[type_index] == type) {
+            uv_mutex_unlock(&tc->instance->mutex_int_const_cache);
+            return;
+        }
     }
     if (right_slot != -1) {
-        return tc->instance->int_const_cache->cache[right_slot][value + 1];
+        int i;
+        for (i = 0; i < MVM_NUMCACHE_VALUES; i++) {
+            MVMObject *obj = MVM_repr_alloc_init(tc, type);
+            MVM_repr_set_num(tc, obj, num_cache_values[i]);
+            cache->num_cache[right_slot][i] = obj;
+        }
+        MVM_barrier();
+        cache->num_types[right_slot] = type;
+        MVM_gc_root_add_permanent_desc(tc,
+            (MVMCollectable **)&cache->num_types[right_slot],
+            "Boxed num cache type");
+    }
+    uv_mutex_unlock(&tc->instance->mutex_int_const_cache);
+}
+
+MVMObject *MVM_numcache_get(MVMThreadContext *tc, MVMObject *type, MVMnum64 value) {
+    MVMIntConstCache *cache = tc->instance->int_const_cache;
+    int type_index, i;
+
+    /* Compare bit patterns, so -0e0 does not get the 0e0 box. */
+    for (type_index = 0; type_index < MVM_INTCACHE_TYPES; type_index++) {
+        if (cache->num_types[type_index] == type) {
+            for (i = 0; i < MVM_NUMCACHE_VALUES; i++)
+                if (memcmp(&value, &num_cache_values[i], sizeof(MVMnum64)) == 0)
+                    return cache->num_cache[type_index][i];
+            return NULL;
+        }
     }
     return NULL;
 }
+
+void MVM_intcache_destroy(MVMThreadContext *tc, MVMIntConstCache *cache) {
+    int type_index;
+    for (type_index = 0; type_index < MVM_INTCACHE_TYPES; type_index++) {
+        MVMIntConstCacheRange *range = cache->ranges[type_index];
+        while (range) {
+            MVMIntConstCacheRange *replaced = range->replaced;
+            MVM_free(range->boxes);
+            MVM_free(range);
+            range = replaced;
+        }
+    }
+    MVM_free(cache);
+}
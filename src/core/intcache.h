@@ -1,7 +1,44 @@
+/* The number of types we keep boxed integer and num caches for. */
+#define MVM_INTCACHE_TYPES 4
+
+/* The range of integers boxed ahead of time for a type, unless its HLL asks
+ * for another with the int_cache_min and int_cache_max config keys, and the
+ * most values we are willing to cache for a type. */
+#define MVM_INTCACHE_DEFAULT_MIN -1
+#define MVM_INTCACHE_DEFAULT_MAX 14
+#define MVM_INTCACHE_MAX_VALUES  65536
+
+/* The number of commonly boxed nums we cache for a type. */
+#define MVM_NUMCACHE_VALUES 5
+
+/* The boxed integers from min to max for a type. A range is never changed
+ * once visible to other threads; growing it installs a new one, so readers
+ * always see bounds that match the boxes. */
+struct MVMIntConstCacheRange {
+    MVMint64    min;
+    MVMint64    max;
+    MVMObject **boxes;
+
+    /* The range this one replaced, freed along with the cache. */
+    MVMIntConstCacheRange *replaced;
+};
+
 struct MVMIntConstCache {
-    MVMObject *types[4];
-    MVMObject *cache[4][16];
+    MVMObject             *types[MVM_INTCACHE_TYPES];
+    MVMIntConstCacheRange *ranges[MVM_INTCACHE_TYPES];
+
+    /* A range being filled in, which the GC must see, though no reader may
+     * yet. */
+    MVMIntConstCacheRange *building;
+
+    /* Boxed nums, for the values in the table in intcache.c. */
+    MVMObject *num_types[MVM_INTCACHE_TYPES];
+    MVMObject *num_cache[MVM_INTCACHE_TYPES][MVM_NUMCACHE_VALUES];
 };
 
 void MVM_intcache_for(MVMThreadContext *tc, MVMObject *type);
+void MVM_intcache_for_range(MVMThreadContext *tc, MVMObject *type, MVMint64 min, MVMint64 max);
 MVMObject *MVM_intcache_get(MVMThreadContext *tc, MVMObject *type, MVMint64 value);
+void MVM_numcache_for(MVMThreadContext *tc, MVMObject *type);
+MVMObject *MVM_numcache_get(MVMThreadContext *tc, MVMObject *type, MVMnum64 value);
+void MVM_intcache_destroy(MVMThreadContext *tc, MVMIntConstCache *cache);
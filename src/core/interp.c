@@ -5159,6 +5159,58 @@ void MVM_interp_run(MVMThreadContext *tc, void (*initial_invoke)(MVMThreadContex
                 cur_op += 6;
                 goto NEXT;
             }
+            OP(strbuilderappend):
+                MVM_string_builder_append(tc, GET_REG(cur_op, 0).o, GET_REG(cur_op, 2).s);
+                cur_op += 4;
+                goto NEXT;
+            OP(strbuilderappendcp):
+                MVM_string_builder_append_codepoint(tc, GET_REG(cur_op, 0).o, GET_REG(cur_op, 2).i64);
+                cur_op += 4;
+                goto NEXT;
+            OP(strbuildertostr):
+                GET_REG(cur_op, 0).s = MVM_string_builder_to_str(tc, GET_REG(cur_op, 2).o);
+                cur_op += 4;
+                goto NEXT;
+            OP(splitnative):
+                MVM_string_split_native(tc, GET_REG(cur_op, 0).s, GET_REG(cur_op, 2).s,
+                    GET_REG(cur_op, 4).o);
+                cur_op += 6;
+                goto NEXT;
+            OP(unicollkey):
+                GET_REG(cur_op, 0).o = MVM_unicode_string_collation_key(tc,
+                    GET_REG(cur_op, 2).s,   GET_REG(cur_op, 4).i64,
+                    GET_REG(cur_op, 6).i64, GET_REG(cur_op, 8).i64,
+                    GET_REG(cur_op, 10).o);
+                cur_op += 12;
+                goto NEXT;
+            OP(queuepushbatch): {
+                MVMObject *queue = GET_REG(cur_op, 0).o;
+                if (REPR(queue)->ID == MVM_REPR_ID_ConcBlockingQueue && IS_CONCRETE(queue))
+                    MVM_concblockingqueue_push_batch(tc, (MVMConcBlockingQueue *)queue,
+                        GET_REG(cur_op, 2).o);
+                else
+                    MVM_exception_throw_adhoc(tc,
+                        "queuepushbatch requires a concrete object with REPR ConcBlockingQueue");
+                cur_op += 4;
+                goto NEXT;
+            }
+            OP(queuepollbatch): {
+                MVMObject *queue = GET_REG(cur_op, 2).o;
+                if (REPR(queue)->ID == MVM_REPR_ID_ConcBlockingQueue && IS_CONCRETE(queue))
+                    GET_REG(cur_op, 0).i64 = MVM_concblockingqueue_poll_batch(tc,
+                        (MVMConcBlockingQueue *)queue, GET_REG(cur_op, 4).o,
+                        GET_REG(cur_op, 6).i64);
+                else
+                    MVM_exception_throw_adhoc(tc,
+                        "queuepollbatch requires a concrete object with REPR ConcBlockingQueue");
+                cur_op += 8;
+                goto NEXT;
+            }
+            OP(caskey_o):
+                GET_REG(cur_op, 0).o = MVM_conchash_cas(tc, GET_REG(cur_op, 2).o,
+                    GET_REG(cur_op, 4).s, GET_REG(cur_op, 6).o, GET_REG(cur_op, 8).o);
+                cur_op += 10;
+                goto NEXT;
             OP(sp_guard): {
                 MVMObject *check = GET_REG(cur_op, 0).o;
                 MVMSTable *want  = (MVMSTable *)tc->cur_frame
@@ -5571,6 +5623,26 @@ void MVM_interp_run(MVMThreadContext *tc, void (*initial_invoke)(MVMThreadContex
                 cur_op += 4;
                 goto NEXT;
             }
+            OP(sp_concat_accum):
+                GET_REG(cur_op, 0).s = MVM_string_builder_concat_accum(tc,
+                    GET_REG(cur_op, 2).s, GET_REG(cur_op, 4).s, GET_REG(cur_op, 6).o);
+                cur_op += 8;
+                goto NEXT;
+            OP(sp_add_I):
+                GET_REG(cur_op, 0).o = MVM_bigint_sp_add(tc, GET_REG(cur_op, 6).o,
+                    GET_REG(cur_op, 2).o, GET_REG(cur_op, 4).o, GET_UI16(cur_op, 8));
+                cur_op += 10;
+                goto NEXT;
+            OP(sp_sub_I):
+                GET_REG(cur_op, 0).o = MVM_bigint_sp_sub(tc, GET_REG(cur_op, 6).o,
+                    GET_REG(cur_op, 2).o, GET_REG(cur_op, 4).o, GET_UI16(cur_op, 8));
+                cur_op += 10;
+                goto NEXT;
+            OP(sp_mul_I):
+                GET_REG(cur_op, 0).o = MVM_bigint_sp_mul(tc, GET_REG(cur_op, 6).o,
+                    GET_REG(cur_op, 2).o, GET_REG(cur_op, 4).o, GET_UI16(cur_op, 8));
+                cur_op += 10;
+                goto NEXT;
             OP(prof_enter):
                 MVM_profile_log_enter(tc, tc->cur_frame->static_info,
                     MVM_PROFILE_ENTER_NORMAL);
@@ -5,11 +5,17 @@
  * really only means we need to do this enough to make sure tight native
  * loops trigger it. */
 /* Don't use a MVM_load(&tc->gc_status) here for performance, it's okay
- * if the interrupt is delayed a bit. */
+ * if the interrupt is delayed a bit. When page-protection safepoints are
+ * enabled, it is instead a load from the thread's safepoint page, which
+ * faults when the thread is to join a GC run. */
+#if MVM_GC_SAFEPOINT_PAGE
+#define GC_SYNC_POINT(tc) MVM_gc_safepoint_poll(tc)
+#else
 #define GC_SYNC_POINT(tc) \
     if (tc->gc_status) { \
         MVM_gc_enter_from_interrupt(tc); \
     }
+#endif
 
 /* Different views of a register. */
 union MVMRegister {
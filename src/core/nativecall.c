@@ -341,6 +341,9 @@ void * MVM_nativecall_unmarshal_vmarray(MVMThreadContext *tc, MVMObject *value)
         MVMArrayBody *body          = &((MVMArray *)value)->body;
         MVMArrayREPRData *repr_data = (MVMArrayREPRData *)STABLE(value)->REPR_data;
         size_t start_pos            = body->start * repr_data->elem_size;
+        if (body->chunks)
+            MVM_exception_throw_adhoc(tc,
+                "Native call cannot pass an array with chunked storage");
         return ((char *)body->slots.any) + start_pos;
     }
     else
@@ -767,6 +767,14 @@ static const void * const LABELS[] = {
     &&OP_eqaticim_s,
     &&OP_indexicim_s,
     &&OP_decodertakecharseof,
+    &&OP_strbuilderappend,
+    &&OP_strbuilderappendcp,
+    &&OP_strbuildertostr,
+    &&OP_splitnative,
+    &&OP_unicollkey,
+    &&OP_queuepushbatch,
+    &&OP_queuepollbatch,
+    &&OP_caskey_o,
     &&OP_sp_guard,
     &&OP_sp_guardconc,
     &&OP_sp_guardtype,
@@ -819,6 +827,10 @@ static const void * const LABELS[] = {
     &&OP_sp_boolify_iter,
     &&OP_sp_boolify_iter_arr,
     &&OP_sp_boolify_iter_hash,
+    &&OP_sp_concat_accum,
+    &&OP_sp_add_I,
+    &&OP_sp_sub_I,
+    &&OP_sp_mul_I,
     &&OP_prof_enter,
     &&OP_prof_enterspesh,
     &&OP_prof_enterinline,
@@ -1013,18 +1025,6 @@ static const void * const LABELS[] = {
     NULL,
     NULL,
     NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
     &&OP_CALL_EXTOP,
     &&OP_CALL_EXTOP,
     &&OP_CALL_EXTOP,
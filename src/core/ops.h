@@ -767,66 +767,78 @@
 #define MVM_OP_eqaticim_s 763
 #define MVM_OP_indexicim_s 764
 #define MVM_OP_decodertakecharseof 765
-#define MVM_OP_sp_guard 766
-#define MVM_OP_sp_guardconc 767
-#define MVM_OP_sp_guardtype 768
-#define MVM_OP_sp_decont 769
-#define MVM_OP_sp_getlex_o 770
-#define MVM_OP_sp_getlex_ins 771
-#define MVM_OP_sp_getlex_no 772
-#define MVM_OP_sp_getarg_o 773
-#define MVM_OP_sp_getarg_i 774
-#define MVM_OP_sp_getarg_n 775
-#define MVM_OP_sp_getarg_s 776
-#define MVM_OP_sp_fastinvoke_v 777
-#define MVM_OP_sp_fastinvoke_i 778
-#define MVM_OP_sp_fastinvoke_n 779
-#define MVM_OP_sp_fastinvoke_s 780
-#define MVM_OP_sp_fastinvoke_o 781
-#define MVM_OP_sp_paramnamesused 782
-#define MVM_OP_sp_getspeshslot 783
-#define MVM_OP_sp_findmeth 784
-#define MVM_OP_sp_fastcreate 785
-#define MVM_OP_sp_get_o 786
-#define MVM_OP_sp_get_i64 787
-#define MVM_OP_sp_get_i32 788
-#define MVM_OP_sp_get_i16 789
-#define MVM_OP_sp_get_i8 790
-#define MVM_OP_sp_get_n 791
-#define MVM_OP_sp_get_s 792
-#define MVM_OP_sp_bind_o 793
-#define MVM_OP_sp_bind_i64 794
-#define MVM_OP_sp_bind_i32 795
-#define MVM_OP_sp_bind_i16 796
-#define MVM_OP_sp_bind_i8 797
-#define MVM_OP_sp_bind_n 798
-#define MVM_OP_sp_bind_s 799
-#define MVM_OP_sp_p6oget_o 800
-#define MVM_OP_sp_p6ogetvt_o 801
-#define MVM_OP_sp_p6ogetvc_o 802
-#define MVM_OP_sp_p6oget_i 803
-#define MVM_OP_sp_p6oget_n 804
-#define MVM_OP_sp_p6oget_s 805
-#define MVM_OP_sp_p6obind_o 806
-#define MVM_OP_sp_p6obind_i 807
-#define MVM_OP_sp_p6obind_n 808
-#define MVM_OP_sp_p6obind_s 809
-#define MVM_OP_sp_deref_get_i64 810
-#define MVM_OP_sp_deref_get_n 811
-#define MVM_OP_sp_deref_bind_i64 812
-#define MVM_OP_sp_deref_bind_n 813
-#define MVM_OP_sp_jit_enter 814
-#define MVM_OP_sp_boolify_iter 815
-#define MVM_OP_sp_boolify_iter_arr 816
-#define MVM_OP_sp_boolify_iter_hash 817
-#define MVM_OP_prof_enter 818
-#define MVM_OP_prof_enterspesh 819
-#define MVM_OP_prof_enterinline 820
-#define MVM_OP_prof_enternative 821
-#define MVM_OP_prof_exit 822
-#define MVM_OP_prof_allocated 823
-#define MVM_OP_ctw_check 824
-#define MVM_OP_coverage_log 825
+#define MVM_OP_strbuilderappend 766
+#define MVM_OP_strbuilderappendcp 767
+#define MVM_OP_strbuildertostr 768
+#define MVM_OP_splitnative 769
+#define MVM_OP_unicollkey 770
+#define MVM_OP_queuepushbatch 771
+#define MVM_OP_queuepollbatch 772
+#define MVM_OP_caskey_o 773
+#define MVM_OP_sp_guard 774
+#define MVM_OP_sp_guardconc 775
+#define MVM_OP_sp_guardtype 776
+#define MVM_OP_sp_decont 777
+#define MVM_OP_sp_getlex_o 778
+#define MVM_OP_sp_getlex_ins 779
+#define MVM_OP_sp_getlex_no 780
+#define MVM_OP_sp_getarg_o 781
+#define MVM_OP_sp_getarg_i 782
+#define MVM_OP_sp_getarg_n 783
+#define MVM_OP_sp_getarg_s 784
+#define MVM_OP_sp_fastinvoke_v 785
+#define MVM_OP_sp_fastinvoke_i 786
+#define MVM_OP_sp_fastinvoke_n 787
+#define MVM_OP_sp_fastinvoke_s 788
+#define MVM_OP_sp_fastinvoke_o 789
+#define MVM_OP_sp_paramnamesused 790
+#define MVM_OP_sp_getspeshslot 791
+#define MVM_OP_sp_findmeth 792
+#define MVM_OP_sp_fastcreate 793
+#define MVM_OP_sp_get_o 794
+#define MVM_OP_sp_get_i64 795
+#define MVM_OP_sp_get_i32 796
+#define MVM_OP_sp_get_i16 797
+#define MVM_OP_sp_get_i8 798
+#define MVM_OP_sp_get_n 799
+#define MVM_OP_sp_get_s 800
+#define MVM_OP_sp_bind_o 801
+#define MVM_OP_sp_bind_i64 802
+#define MVM_OP_sp_bind_i32 803
+#define MVM_OP_sp_bind_i16 804
+#define MVM_OP_sp_bind_i8 805
+#define MVM_OP_sp_bind_n 806
+#define MVM_OP_sp_bind_s 807
+#define MVM_OP_sp_p6oget_o 808
+#define MVM_OP_sp_p6ogetvt_o 809
+#define MVM_OP_sp_p6ogetvc_o 810
+#define MVM_OP_sp_p6oget_i 811
+#define MVM_OP_sp_p6oget_n 812
+#define MVM_OP_sp_p6oget_s 813
+#define MVM_OP_sp_p6obind_o 814
+#define MVM_OP_sp_p6obind_i 815
+#define MVM_OP_sp_p6obind_n 816
+#define MVM_OP_sp_p6obind_s 817
+#define MVM_OP_sp_deref_get_i64 818
+#define MVM_OP_sp_deref_get_n 819
+#define MVM_OP_sp_deref_bind_i64 820
+#define MVM_OP_sp_deref_bind_n 821
+#define MVM_OP_sp_jit_enter 822
+#define MVM_OP_sp_boolify_iter 823
+#define MVM_OP_sp_boolify_iter_arr 824
+#define MVM_OP_sp_boolify_iter_hash 825
+#define MVM_OP_sp_concat_accum 826
+#define MVM_OP_sp_add_I 827
+#define MVM_OP_sp_sub_I 828
+#define MVM_OP_sp_mul_I 829
+#define MVM_OP_prof_enter 830
+#define MVM_OP_prof_enterspesh 831
+#define MVM_OP_prof_enterinline 832
+#define MVM_OP_prof_enternative 833
+#define MVM_OP_prof_exit 834
+#define MVM_OP_prof_allocated 835
+#define MVM_OP_ctw_check 836
+#define MVM_OP_coverage_log 837
 
 #define MVM_OP_EXT_BASE 1024
 #define MVM_OP_EXT_CU_LIMIT 1024
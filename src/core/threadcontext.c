@@ -5,7 +5,7 @@
  * thread itself, it just creates the data structure that exists in
  * MoarVM per thread. */
 MVMThreadContext * MVM_tc_create(MVMThreadContext *parent, MVMInstance *instance) {
-    MVMThreadContext *tc = MVM_calloc(1, sizeof(MVMThreadContext));
+    MVMThreadContext *tc = MVM_gc_safepoint_tc_alloc();
 
     /* Associate with VM instance. */
     tc->instance = instance;
@@ -18,7 +18,7 @@ MVMThreadContext * MVM_tc_create(MVMThreadContext *parent, MVMInstance *instance
         r = uv_loop_init(tc->loop);
         if (r < 0) {
             MVM_free(tc->loop);
-            MVM_free(tc);
+            MVM_gc_safepoint_tc_free(tc);
             MVM_exception_throw_adhoc(parent, "Could not create a new Thread: %s", uv_strerror(r));
         }
     } else {
@@ -106,7 +106,7 @@ void MVM_tc_destroy(MVMThreadContext *tc) {
 
     /* Free the thread context itself. */
     memset(tc, 0, sizeof(MVMThreadContext));
-    MVM_free(tc);
+    MVM_gc_safepoint_tc_free(tc);
 }
 
 /* Setting and clearing mutex to release on exception throw. */
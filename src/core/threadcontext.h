@@ -63,6 +63,14 @@ struct MVMThreadContext {
     /* This thread's GC status. */
     AO_t gc_status;
 
+    /* Guard page in front of this thread context, read at GC sync points
+     * when page-protection safepoints are enabled; protected to make the
+     * thread join a GC run. Also where to resume after a poll faulted, and
+     * whether the page is currently protected. */
+    void     *gc_safepoint_page;
+    void     *gc_safepoint_resume;
+    MVMuint8  gc_safepoint_armed;
+
     /* The second GC generation allocator. */
     MVMGen2Allocator *gen2;
 
@@ -70,6 +70,9 @@ static void start_thread(void *data) {
     /* Stash thread ID. */
     tc->thread_obj->body.native_thread_id = MVM_platform_thread_id();
 
+    /* Let the GC safepoint fault handler find this thread context. */
+    MVM_gc_safepoint_thread_started(tc);
+
     /* wait for the GC to finish if it's not finished stealing us. */
     MVM_gc_mark_thread_unblocked(tc);
     tc->thread_obj->body.stage = MVM_thread_stage_started;
@@ -32,6 +32,7 @@ static MVMuint32 signal_one_thread(MVMThreadContext *tc, MVMThreadContext *to_si
                 /* Try to set it from running to interrupted - the common case. */
                 if (MVM_cas(&to_signal->gc_status, MVMGCStatus_NONE,
                         MVMGCStatus_INTERRUPT) == MVMGCStatus_NONE) {
+                    MVM_gc_safepoint_arm(to_signal);
                     GCDEBUG_LOG(tc, MVM_GC_DEBUG_ORCHESTRATE, "Thread %d run %d : Signalled thread %d to interrupt\n", to_signal->thread_id);
                     return 1;
                 }
@@ -161,6 +162,10 @@ static void finish_gc(MVMThreadContext *tc, MVMuint8 gen, MVMuint8 is_coordinato
         MVM_finalize_walk_queues(tc, gen);
         clear_intrays(tc, gen);
 
+        GCDEBUG_LOG(tc, MVM_GC_DEBUG_ORCHESTRATE,
+            "Thread %d run %d : Co-ordinator purging dead interned strings\n");
+        MVM_string_intern_purge(tc, gen);
+
         if (gen == MVMGCGenerations_Both) {
             MVMThread *cur_thread = (MVMThread *)MVM_load(&tc->instance->threads);
             GCDEBUG_LOG(tc, MVM_GC_DEBUG_ORCHESTRATE,
@@ -239,6 +244,7 @@ static void finish_gc(MVMThreadContext *tc, MVMuint8 gen, MVMuint8 is_coordinato
             }
 
             /* Mark thread free to continue. */
+            MVM_gc_safepoint_disarm(other);
             MVM_cas(&other->gc_status, MVMGCStatus_STOLEN, MVMGCStatus_UNABLE);
             MVM_cas(&other->gc_status, MVMGCStatus_INTERRUPT, MVMGCStatus_NONE);
         }
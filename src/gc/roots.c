@@ -69,7 +69,8 @@ void MVM_gc_root_add_instance_roots_to_worklist(MVMThreadContext *tc, MVMGCWorkl
     MVMLoadedCompUnitName       *current_lcun, *tmp_lcun;
     unsigned                     bucket_tmp;
     MVMString                  **int_to_str_cache;
-    MVMuint32                    i;
+    MVMIntConstCache            *int_const_cache;
+    MVMuint32                    i, j;
 
     add_collectable(tc, worklist, snapshot, tc->instance->threads, "Thread list");
     add_collectable(tc, worklist, snapshot, tc->instance->compiler_registry, "Compiler registry");
@@ -92,6 +93,24 @@ void MVM_gc_root_add_instance_roots_to_worklist(MVMThreadContext *tc, MVMGCWorkl
         add_collectable(tc, worklist, snapshot, int_to_str_cache[i],
             "Integer to string cache entry");
 
+    int_const_cache = tc->instance->int_const_cache;
+    if (int_const_cache->building) {
+        MVMIntConstCacheRange *range = int_const_cache->building;
+        for (j = 0; j <= range->max - range->min; j++)
+            add_collectable(tc, worklist, snapshot, range->boxes[j],
+                "Boxed integer cache entry");
+    }
+    for (i = 0; i < MVM_INTCACHE_TYPES; i++) {
+        MVMIntConstCacheRange *range = int_const_cache->ranges[i];
+        if (range)
+            for (j = 0; j <= range->max - range->min; j++)
+                add_collectable(tc, worklist, snapshot, range->boxes[j],
+                    "Boxed integer cache entry");
+        for (j = 0; j < MVM_NUMCACHE_VALUES; j++)
+            add_collectable(tc, worklist, snapshot, int_const_cache->num_cache[i][j],
+                "Boxed num cache entry");
+    }
+
     /* okay, so this makes the weak hash slightly less weak.. for certain
      * keys of it anyway... */
     HASH_ITER(hash_handle, tc->instance->sc_weakhash, current, tmp, bucket_tmp) {
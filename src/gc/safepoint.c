@@ -0,0 +1,207 @@
+/* For REG_RIP from <ucontext.h> */
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+#include "moar.h"
+#include "platform/mmap.h"
+
+#if MVM_GC_SAFEPOINT_PAGE
+
+#if !defined(__linux__) || !defined(__x86_64__)
+#error "Page-protection GC safepoints are only supported on Linux on x86-64"
+#endif
+
+#include <signal.h>
+#include <ucontext.h>
+#include <unistd.h>
+
+/* The thread context of the thread we are running on, so the fault handler
+ * can tell whether a fault is on the current thread's safepoint page. It is
+ * set when the thread starts, before any poll, so reading it in the handler
+ * never needs to allocate thread local storage. */
+static __thread MVMThreadContext *current_tc = NULL;
+
+/* Handlers that were installed before ours, which we chain to for any fault
+ * that is not a safepoint poll. */
+static struct sigaction prev_segv_action;
+static struct sigaction prev_bus_action;
+
+static size_t page_size(void) {
+    static size_t size = 0;
+    if (!size)
+        size = (size_t)sysconf(_SC_PAGESIZE);
+    return size;
+}
+
+/* Size of the guard area in front of the thread context; at least a page,
+ * and enough that MVM_GC_SAFEPOINT_DISP lands in it. */
+static size_t guard_size(void) {
+    size_t size = page_size();
+    while (size < (size_t)-MVM_GC_SAFEPOINT_DISP)
+        size += page_size();
+    return size;
+}
+
+static size_t tc_alloc_size(void) {
+    size_t pages = (sizeof(MVMThreadContext) + page_size() - 1) / page_size();
+    return guard_size() + pages * page_size();
+}
+
+/* Entered through the trampoline below when a poll faults. Joins the GC run
+ * and returns the address of the poll, which is then re-executed. */
+void * MVM_gc_safepoint_trap(void);
+void * MVM_gc_safepoint_trap(void) {
+    MVMThreadContext *tc     = current_tc;
+    void             *resume = tc->gc_safepoint_resume;
+    MVM_gc_enter_from_interrupt(tc);
+    return resume;
+}
+
+/* The fault handler sends the thread here in place of the poll that faulted.
+ * This steps over the red zone, leaving a slot for the resume address, then
+ * saves the flags, the caller-saved general purpose registers and the x87
+ * and SSE state, since any of them may be live at the poll. rbx is saved
+ * too, as it holds the stack pointer from before aligning the stack for
+ * the call. On the way out, ret pops the resume address and drops the red
+ * zone, leaving the stack as it was at the poll. */
+void MVM_gc_safepoint_trampoline(void);
+__asm__(
+    "    .text\n"
+    "    .p2align 4\n"
+    "    .globl MVM_gc_safepoint_trampoline\n"
+    "    .hidden MVM_gc_safepoint_trampoline\n"
+    "    .type MVM_gc_safepoint_trampoline, @function\n"
+    "MVM_gc_safepoint_trampoline:\n"
+    "    lea -136(%rsp), %rsp\n"
+    "    pushfq\n"
+    "    push %rax\n"
+    "    push %rcx\n"
+    "    push %rdx\n"
+    "    push %rsi\n"
+    "    push %rdi\n"
+    "    push %r8\n"
+    "    push %r9\n"
+    "    push %r10\n"
+    "    push %r11\n"
+    "    push %rbx\n"
+    "    mov %rsp, %rbx\n"
+    "    sub $512, %rsp\n"
+    "    and $-16, %rsp\n"
+    "    fxsave64 (%rsp)\n"
+    "    cld\n"
+    "    call MVM_gc_safepoint_trap@PLT\n"
+    "    fxrstor64 (%rsp)\n"
+    "    mov %rax, 88(%rbx)\n"
+    "    mov %rbx, %rsp\n"
+    "    pop %rbx\n"
+    "    pop %r11\n"
+    "    pop %r10\n"
+    "    pop %r9\n"
+    "    pop %r8\n"
+    "    pop %rdi\n"
+    "    pop %rsi\n"
+    "    pop %rdx\n"
+    "    pop %rcx\n"
+    "    pop %rax\n"
+    "    popfq\n"
+    "    ret $128\n"
+    "    .size MVM_gc_safepoint_trampoline, .-MVM_gc_safepoint_trampoline\n"
+);
+
+static void chain_to_previous(int sig, siginfo_t *info, void *context) {
+    struct sigaction *prev = sig == SIGBUS ? &prev_bus_action : &prev_segv_action;
+    if (prev->sa_flags & SA_SIGINFO) {
+        prev->sa_sigaction(sig, info, context);
+    }
+    else if (prev->sa_handler == SIG_DFL || prev->sa_handler == SIG_IGN) {
+        /* Put the previous disposition back; returning re-executes the
+         * faulting instruction, which will then get the default action. */
+        sigaction(sig, prev, NULL);
+    }
+    else {
+        prev->sa_handler(sig);
+    }
+}
+
+/* Fault handler. Joining the GC run allocates, locks and waits, none of
+ * which may be done in a signal handler, so all we do is note where the
+ * poll was and resume the thread in the trampoline instead. */
+static void safepoint_fault_handler(int sig, siginfo_t *info, void *context) {
+    MVMThreadContext *tc = current_tc;
+    if (tc && (char *)info->si_addr == (char *)tc + MVM_GC_SAFEPOINT_DISP) {
+        ucontext_t *uc = (ucontext_t *)context;
+        tc->gc_safepoint_resume = (void *)uc->uc_mcontext.gregs[REG_RIP];
+        uc->uc_mcontext.gregs[REG_RIP] = (greg_t)MVM_gc_safepoint_trampoline;
+        return;
+    }
+    chain_to_previous(sig, info, context);
+}
+
+/* Allocates a zeroed thread context, with the readable guard page that is
+ * polled at safepoints in front of it. */
+MVMThreadContext * MVM_gc_safepoint_tc_alloc(void) {
+    char *block = MVM_platform_alloc_pages(tc_alloc_size(),
+        MVM_PAGE_READ | MVM_PAGE_WRITE);
+    MVMThreadContext *tc;
+    if (!MVM_platform_set_page_mode(block, guard_size(), MVM_PAGE_READ))
+        MVM_panic(1, "Could not set up GC safepoint page");
+    tc = (MVMThreadContext *)(block + guard_size());
+    tc->gc_safepoint_page = block;
+    return tc;
+}
+
+/* Frees a thread context along with its guard page. */
+void MVM_gc_safepoint_tc_free(MVMThreadContext *tc) {
+    MVM_platform_free_pages((char *)tc - guard_size(), tc_alloc_size());
+}
+
+/* Installs the fault handler; done once at VM startup. */
+void MVM_gc_safepoint_install_handler(MVMInstance *instance) {
+    struct sigaction action;
+    memset(&action, 0, sizeof(struct sigaction));
+    action.sa_sigaction = safepoint_fault_handler;
+    action.sa_flags     = SA_SIGINFO | SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    if (sigaction(SIGSEGV, &action, &prev_segv_action) != 0 ||
+            sigaction(SIGBUS, &action, &prev_bus_action) != 0)
+        MVM_panic(1, "Could not install GC safepoint fault handler");
+}
+
+/* Must be called on the OS thread that will run code using the specified
+ * thread context, before it reaches any safepoint poll. */
+void MVM_gc_safepoint_thread_started(MVMThreadContext *tc) {
+    current_tc = tc;
+}
+
+/* Protects the page, so the next poll by the thread faults. Called by the
+ * GC co-ordinator after it sets the thread's status to interrupted. */
+void MVM_gc_safepoint_arm(MVMThreadContext *tc) {
+    if (!MVM_platform_set_page_mode(tc->gc_safepoint_page, guard_size(), 0))
+        MVM_panic(MVM_exitcode_gcorch, "Could not protect GC safepoint page");
+    tc->gc_safepoint_armed = 1;
+}
+
+/* Makes the page readable again once the GC run is over, if it was
+ * protected for it. */
+void MVM_gc_safepoint_disarm(MVMThreadContext *tc) {
+    if (!tc->gc_safepoint_armed)
+        return;
+    if (!MVM_platform_set_page_mode(tc->gc_safepoint_page, guard_size(), MVM_PAGE_READ))
+        MVM_panic(MVM_exitcode_gcorch, "Could not unprotect GC safepoint page");
+    tc->gc_safepoint_armed = 0;
+}
+
+#else
+
+MVMThreadContext * MVM_gc_safepoint_tc_alloc(void) {
+    return MVM_calloc(1, sizeof(MVMThreadContext));
+}
+void MVM_gc_safepoint_tc_free(MVMThreadContext *tc) {
+    MVM_free(tc);
+}
+void MVM_gc_safepoint_install_handler(MVMInstance *instance) { }
+void MVM_gc_safepoint_thread_started(MVMThreadContext *tc) { }
+void MVM_gc_safepoint_arm(MVMThreadContext *tc) { }
+void MVM_gc_safepoint_disarm(MVMThreadContext *tc) { }
+
+#endif
@@ -0,0 +1,34 @@
+/* Optional page-protection based GC safepoint polling. When enabled, each
+ * thread context is allocated directly after a guard page, and GC sync
+ * points in the interpreter and JIT-compiled code are a single load from
+ * that page at a fixed offset from the thread context, with no compare and
+ * no branch. To make a thread join a GC run, the co-ordinator protects the
+ * page. The fault handler does nothing but point the thread at a trampoline
+ * that saves all registers, enters the GC and then resumes at the load,
+ * which is re-executed once the page has been unprotected. This is only
+ * supported on Linux on x86-64; enable it by building with
+ * MVM_GC_SAFEPOINT_PAGE=1. */
+#ifndef MVM_GC_SAFEPOINT_PAGE
+#define MVM_GC_SAFEPOINT_PAGE 0
+#endif
+
+/* Offset from a thread context to the byte of its guard page that is read
+ * at safepoints. */
+#define MVM_GC_SAFEPOINT_DISP (-4096)
+
+MVMThreadContext * MVM_gc_safepoint_tc_alloc(void);
+void MVM_gc_safepoint_tc_free(MVMThreadContext *tc);
+void MVM_gc_safepoint_install_handler(MVMInstance *instance);
+void MVM_gc_safepoint_thread_started(MVMThreadContext *tc);
+void MVM_gc_safepoint_arm(MVMThreadContext *tc);
+void MVM_gc_safepoint_disarm(MVMThreadContext *tc);
+
+#if MVM_GC_SAFEPOINT_PAGE
+/* The read must really happen, since it is what faults. The GC may run
+ * during it, so the compiler must not keep values loaded from memory
+ * across it. */
+#define MVM_gc_safepoint_poll(tc) do { \
+    (void)*(volatile MVMuint8 *)((char *)(tc) + MVM_GC_SAFEPOINT_DISP); \
+    __asm__ __volatile__("" ::: "memory"); \
+} while (0)
+#endif
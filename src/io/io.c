@@ -153,6 +153,30 @@ void MVM_io_write_bytes_c(MVMThreadContext *tc, MVMObject *oshandle, char *outpu
         MVM_exception_throw_adhoc(tc, "Cannot write bytes to this kind of handle");
 }
 
+/* Writes a string to the handle as UTF-8. Handles that know how to encode
+ * straight into their own buffers do so; otherwise we encode and write. */
+void MVM_io_write_string_utf8(MVMThreadContext *tc, MVMObject *oshandle, MVMString *s,
+                              MVMint32 translate_newlines) {
+    MVMOSHandle *handle = verify_is_handle(tc, oshandle, "write string");
+    if (handle->body.ops->sync_writable) {
+        if (handle->body.ops->sync_writable->write_str) {
+            uv_mutex_t *mutex = acquire_mutex(tc, handle);
+            handle->body.ops->sync_writable->write_str(tc, handle, s, translate_newlines);
+            release_mutex(tc, mutex);
+        }
+        else {
+            MVMuint64 encoded_size;
+            char *encoded = MVM_string_utf8_encode(tc, s, &encoded_size, translate_newlines);
+            uv_mutex_t *mutex = acquire_mutex(tc, handle);
+            handle->body.ops->sync_writable->write_bytes(tc, handle, encoded, encoded_size);
+            release_mutex(tc, mutex);
+            MVM_free(encoded);
+        }
+    }
+    else
+        MVM_exception_throw_adhoc(tc, "Cannot write string to this kind of handle");
+}
+
 MVMObject * MVM_io_read_bytes_async(MVMThreadContext *tc, MVMObject *oshandle, MVMObject *queue,
                                     MVMObject *schedulee, MVMObject *buf_type, MVMObject *async_type) {
     MVMOSHandle *handle = verify_is_handle(tc, oshandle, "read bytes asynchronously");
@@ -38,6 +38,11 @@ struct MVMIOSyncWritable {
     MVMint64 (*write_bytes) (MVMThreadContext *tc, MVMOSHandle *h, char *buf, MVMint64 bytes);
     void (*flush) (MVMThreadContext *tc, MVMOSHandle *h);
     void (*truncate) (MVMThreadContext *tc, MVMOSHandle *h, MVMint64 bytes);
+
+    /* Optional; writes a string encoded as UTF-8 without first producing an
+     * encoded copy of it. */
+    MVMint64 (*write_str) (MVMThreadContext *tc, MVMOSHandle *h, MVMString *s,
+        MVMint32 translate_newlines);
 };
 
 /* I/O operations on handles that can do asynchronous reading. */
@@ -96,6 +101,8 @@ void MVM_io_write_bytes_c(MVMThreadContext *tc, MVMObject *oshandle, char *outpu
     MVMuint64 output_size);
 MVMObject * MVM_io_read_bytes_async(MVMThreadContext *tc, MVMObject *oshandle, MVMObject *queue,
     MVMObject *schedulee, MVMObject *buf_type, MVMObject *async_type);
+void MVM_io_write_string_utf8(MVMThreadContext *tc, MVMObject *oshandle, MVMString *s,
+                              MVMint32 translate_newlines);
 MVMObject * MVM_io_write_bytes_async(MVMThreadContext *tc, MVMObject *oshandle, MVMObject *queue,
         MVMObject *schedulee, MVMObject *buffer, MVMObject *async_type);
 MVMObject * MVM_io_write_bytes_to_async(MVMThreadContext *tc, MVMObject *oshandle, MVMObject *queue,
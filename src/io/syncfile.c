@@ -208,6 +208,57 @@ static MVMint64 write_bytes(MVMThreadContext *tc, MVMOSHandle *h, char *buf, MVM
     return bytes;
 }
 
+/* Writes the specified string to the file handle as UTF-8, encoding it right
+ * into the output buffer if there is one, and otherwise through a buffer on
+ * the stack, so we never build up an encoded copy of the whole string. */
+static MVMint64 write_str(MVMThreadContext *tc, MVMOSHandle *h, MVMString *s,
+        MVMint32 translate_newlines) {
+    MVMIOFileData  *data   = (MVMIOFileData *)h->body.data;
+    MVMStringIndex  graphs = MVM_string_graphs(tc, s);
+    MVMStringIndex  pos    = 0;
+    MVMint64        total  = 0;
+    char            stack_buffer[4096];
+
+    /* We write as we encode, so make sure we will not fail part way. */
+    MVM_string_utf8_check_encodable(tc, s);
+    MVMROOT(tc, s, {
+        while (pos < graphs) {
+            MVMuint64 written;
+            if (data->output_buffer_size) {
+                written = MVM_string_utf8_encode_into(tc, s, &pos,
+                    data->output_buffer + data->output_buffer_used,
+                    data->output_buffer_size - data->output_buffer_used,
+                    translate_newlines);
+                data->output_buffer_used += written;
+                if (pos < graphs && written == 0 && data->output_buffer_used == 0)
+                    break;
+                if (pos < graphs)
+                    flush_output_buffer(tc, data);
+            }
+            else {
+                written = MVM_string_utf8_encode_into(tc, s, &pos, stack_buffer,
+                    sizeof(stack_buffer), translate_newlines);
+                if (written == 0)
+                    break;
+                perform_write(tc, data, stack_buffer, written);
+            }
+            total += written;
+        }
+
+        /* A grapheme too big for the buffer means we've some left over, so
+         * fall back to encoding the rest up front. */
+        if (pos < graphs) {
+            MVMuint64  rest_size;
+            char      *rest = MVM_string_utf8_encode_substr(tc, s, &rest_size, pos,
+                graphs - pos, NULL, translate_newlines);
+            perform_write(tc, data, rest, rest_size);
+            MVM_free(rest);
+            total += rest_size;
+        }
+    });
+    return total;
+}
+
 /* Flushes the file handle. */
 static void flush(MVMThreadContext *tc, MVMOSHandle *h){
     MVMIOFileData *data = (MVMIOFileData *)h->body.data;
@@ -352,7 +403,7 @@ static void gc_free(MVMThreadContext *tc, MVMObject *h, void *d) {
 /* IO ops table, populated with functions. */
 static const MVMIOClosable      closable      = { closefh };
 static const MVMIOSyncReadable  sync_readable = { read_bytes, mvm_eof };
-static const MVMIOSyncWritable  sync_writable = { write_bytes, flush, truncatefh };
+static const MVMIOSyncWritable  sync_writable = { write_bytes, flush, truncatefh, write_str };
 static const MVMIOSeekable      seekable      = { seek, mvm_tell };
 static const MVMIOLockable      lockable      = { lock, unlock };
 static const MVMIOIntrospection introspection = { is_tty, mvm_fileno };
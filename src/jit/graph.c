@@ -1,5 +1,6 @@
 #include "moar.h"
 #include "math.h"
+#include "strings/unicode_ops.h"
 
 typedef struct {
     MVMSpeshGraph *sg;
@@ -306,6 +307,13 @@ static void * op_to_func(MVMThreadContext *tc, MVMint16 opcode) {
     case MVM_OP_encode: return MVM_string_encode_to_buf;
     case MVM_OP_decoderaddbytes: return MVM_decoder_add_bytes;
     case MVM_OP_decodertakeline: return MVM_decoder_take_line;
+    case MVM_OP_strbuilderappend: return MVM_string_builder_append;
+    case MVM_OP_strbuilderappendcp: return MVM_string_builder_append_codepoint;
+    case MVM_OP_strbuildertostr: return MVM_string_builder_to_str;
+    case MVM_OP_splitnative: return MVM_string_split_native;
+    case MVM_OP_unicollkey: return MVM_unicode_string_collation_key;
+    case MVM_OP_caskey_o: return MVM_conchash_cas;
+    case MVM_OP_sp_concat_accum: return MVM_string_builder_concat_accum;
 
     case MVM_OP_elems: return MVM_repr_elems;
     case MVM_OP_concat_s: return MVM_string_concatenate;
@@ -342,6 +350,9 @@ static void * op_to_func(MVMThreadContext *tc, MVMint16 opcode) {
     case MVM_OP_add_I: return MVM_bigint_add;
     case MVM_OP_sub_I: return MVM_bigint_sub;
     case MVM_OP_mul_I: return MVM_bigint_mul;
+    case MVM_OP_sp_add_I: return MVM_bigint_sp_add;
+    case MVM_OP_sp_sub_I: return MVM_bigint_sp_sub;
+    case MVM_OP_sp_mul_I: return MVM_bigint_sp_mul;
     case MVM_OP_div_I: return MVM_bigint_div;
     case MVM_OP_bor_I: return MVM_bigint_or;
     case MVM_OP_band_I: return MVM_bigint_and;
@@ -407,26 +418,41 @@ static void * op_to_func(MVMThreadContext *tc, MVMint16 opcode) {
     }
 }
 
-static void jgb_append_guard(MVMThreadContext *tc, JitGraphBuilder *jgb,
-                             MVMSpeshIns *ins) {
-    MVMSpeshAnn   *ann = ins->annotations;
-    MVMJitNode   *node = MVM_spesh_alloc(tc, jgb->sg, sizeof(MVMJitNode));
-    MVMint32 deopt_idx;
-    node->type = MVM_JIT_NODE_GUARD;
-    node->u.guard.ins = ins;
+static MVMSpeshAnn * find_deopt_one_ann(MVMSpeshIns *ins) {
+    MVMSpeshAnn *ann = ins->annotations;
     while (ann) {
         if (ann->type == MVM_SPESH_ANN_DEOPT_ONE_INS ||
-            ann->type == MVM_SPESH_ANN_DEOPT_INLINE) {
-            deopt_idx = ann->data.deopt_idx;
-            break;
-        }
+            ann->type == MVM_SPESH_ANN_DEOPT_INLINE)
+            return ann;
         ann = ann->next;
     }
+    return NULL;
+}
+
+static void jgb_append_guard(MVMThreadContext *tc, JitGraphBuilder *jgb,
+                             MVMSpeshIns *ins) {
+    MVMSpeshAnn   *ann = find_deopt_one_ann(ins);
+    MVMJitNode   *node = MVM_spesh_alloc(tc, jgb->sg, sizeof(MVMJitNode));
+    MVMint32 deopt_idx;
     if (!ann) {
         MVM_oops(tc, "Can't find deopt idx annotation on spesh ins <%s>",
             ins->info->name);
     }
-    node->u.guard.deopt_target = ins->operands[2].lit_ui32;
+    deopt_idx = ann->data.deopt_idx;
+    node->type = MVM_JIT_NODE_GUARD;
+    node->u.guard.ins = ins;
+    switch (ins->info->opcode) {
+    case MVM_OP_sp_add_I:
+    case MVM_OP_sp_sub_I:
+    case MVM_OP_sp_mul_I:
+        /* These deopt to just before themselves, where the interpreter will
+         * run the generic op. */
+        node->u.guard.deopt_target = jgb->sg->deopt_addrs[2 * deopt_idx];
+        break;
+    default:
+        node->u.guard.deopt_target = ins->operands[2].lit_ui32;
+        break;
+    }
     node->u.guard.deopt_offset = jgb->sg->deopt_addrs[2 * deopt_idx + 1];
     jgb_append_node(jgb, node);
 }
@@ -2232,6 +2258,83 @@ static MVMint32 jgb_consume_ins(MVMThreadContext *tc, JitGraphBuilder *jgb,
                           MVM_JIT_RV_PTR, dst);
         break;
     }
+    case MVM_OP_sp_concat_accum: {
+        MVMint16 dst     = ins->operands[0].reg.orig;
+        MVMint16 src_a   = ins->operands[1].reg.orig;
+        MVMint16 src_b   = ins->operands[2].reg.orig;
+        MVMint16 builder = ins->operands[3].reg.orig;
+        MVMJitCallArg args[] = { { MVM_JIT_INTERP_VAR, { MVM_JIT_INTERP_TC } },
+                                 { MVM_JIT_REG_VAL, { src_a } },
+                                 { MVM_JIT_REG_VAL, { src_b } },
+                                 { MVM_JIT_REG_VAL, { builder } } };
+        jgb_append_call_c(tc, jgb, op_to_func(tc, op), 4, args,
+                          MVM_JIT_RV_PTR, dst);
+        break;
+    }
+    case MVM_OP_strbuilderappend:
+    case MVM_OP_strbuilderappendcp: {
+        MVMint16 builder = ins->operands[0].reg.orig;
+        MVMint16 value   = ins->operands[1].reg.orig;
+        MVMJitCallArg args[] = { { MVM_JIT_INTERP_VAR, { MVM_JIT_INTERP_TC } },
+                                 { MVM_JIT_REG_VAL, { builder } },
+                                 { MVM_JIT_REG_VAL, { value } } };
+        jgb_append_call_c(tc, jgb, op_to_func(tc, op), 3, args,
+                          MVM_JIT_RV_VOID, -1);
+        break;
+    }
+    case MVM_OP_splitnative: {
+        MVMint16 separator = ins->operands[0].reg.orig;
+        MVMint16 input     = ins->operands[1].reg.orig;
+        MVMint16 target    = ins->operands[2].reg.orig;
+        MVMJitCallArg args[] = { { MVM_JIT_INTERP_VAR, { MVM_JIT_INTERP_TC } },
+                                 { MVM_JIT_REG_VAL, { separator } },
+                                 { MVM_JIT_REG_VAL, { input } },
+                                 { MVM_JIT_REG_VAL, { target } } };
+        jgb_append_call_c(tc, jgb, op_to_func(tc, op), 4, args,
+                          MVM_JIT_RV_VOID, -1);
+        break;
+    }
+    case MVM_OP_unicollkey: {
+        MVMint16 dst     = ins->operands[0].reg.orig;
+        MVMint16 str     = ins->operands[1].reg.orig;
+        MVMint16 mode    = ins->operands[2].reg.orig;
+        MVMint16 lang    = ins->operands[3].reg.orig;
+        MVMint16 country = ins->operands[4].reg.orig;
+        MVMint16 buf     = ins->operands[5].reg.orig;
+        MVMJitCallArg args[] = { { MVM_JIT_INTERP_VAR, { MVM_JIT_INTERP_TC } },
+                                 { MVM_JIT_REG_VAL, { str } },
+                                 { MVM_JIT_REG_VAL, { mode } },
+                                 { MVM_JIT_REG_VAL, { lang } },
+                                 { MVM_JIT_REG_VAL, { country } },
+                                 { MVM_JIT_REG_VAL, { buf } } };
+        jgb_append_call_c(tc, jgb, op_to_func(tc, op), 6, args,
+                          MVM_JIT_RV_PTR, dst);
+        break;
+    }
+    case MVM_OP_caskey_o: {
+        MVMint16 dst      = ins->operands[0].reg.orig;
+        MVMint16 hash     = ins->operands[1].reg.orig;
+        MVMint16 key      = ins->operands[2].reg.orig;
+        MVMint16 expected = ins->operands[3].reg.orig;
+        MVMint16 value    = ins->operands[4].reg.orig;
+        MVMJitCallArg args[] = { { MVM_JIT_INTERP_VAR, { MVM_JIT_INTERP_TC } },
+                                 { MVM_JIT_REG_VAL, { hash } },
+                                 { MVM_JIT_REG_VAL, { key } },
+                                 { MVM_JIT_REG_VAL, { expected } },
+                                 { MVM_JIT_REG_VAL, { value } } };
+        jgb_append_call_c(tc, jgb, op_to_func(tc, op), 5, args,
+                          MVM_JIT_RV_PTR, dst);
+        break;
+    }
+    case MVM_OP_strbuildertostr: {
+        MVMint16 dst     = ins->operands[0].reg.orig;
+        MVMint16 builder = ins->operands[1].reg.orig;
+        MVMJitCallArg args[] = { { MVM_JIT_INTERP_VAR, { MVM_JIT_INTERP_TC } },
+                                 { MVM_JIT_REG_VAL, { builder } } };
+        jgb_append_call_c(tc, jgb, op_to_func(tc, op), 2, args,
+                          MVM_JIT_RV_PTR, dst);
+        break;
+    }
     case MVM_OP_escape:
     case MVM_OP_uc:
     case MVM_OP_lc:
@@ -2509,6 +2612,29 @@ static MVMint32 jgb_consume_ins(MVMThreadContext *tc, JitGraphBuilder *jgb,
                           MVM_JIT_RV_PTR, dst);
         break;
     }
+    case MVM_OP_sp_add_I:
+    case MVM_OP_sp_sub_I:
+    case MVM_OP_sp_mul_I: {
+        MVMint16 src_a  = ins->operands[1].reg.orig;
+        MVMint16 src_b  = ins->operands[2].reg.orig;
+        MVMint16 type   = ins->operands[3].reg.orig;
+        MVMint16 offset = ins->operands[4].lit_i16;
+        MVMint16 dst    = ins->operands[0].reg.orig;
+        MVMJitCallArg args[] = { { MVM_JIT_INTERP_VAR, { MVM_JIT_INTERP_TC } },
+                                 { MVM_JIT_REG_VAL, { type } },
+                                 { MVM_JIT_REG_VAL, { src_a } },
+                                 { MVM_JIT_REG_VAL, { src_b } },
+                                 { MVM_JIT_LITERAL, { offset } } };
+        /* With a deopt point to fall back to, the smallint arithmetic is
+         * done inline, deopting to the generic op when an operand is not a
+         * smallint of the result type or the result overflows. */
+        if (find_deopt_one_ann(ins))
+            jgb_append_guard(tc, jgb, ins);
+        else
+            jgb_append_call_c(tc, jgb, op_to_func(tc, op), 5, args,
+                              MVM_JIT_RV_PTR, dst);
+        break;
+    }
     case MVM_OP_pow_I: {
         MVMint16 src_a  = ins->operands[1].reg.orig;
         MVMint16 src_b  = ins->operands[2].reg.orig;
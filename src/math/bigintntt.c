@@ -0,0 +1,246 @@
+#include "moar.h"
+
+/* Multiplication of big integers by number theoretic transform. Each operand
+ * is cut into coefficients of a few bits, which are convolved by transforming
+ * them modulo the prime 2^64 - 2^32 + 1. That prime has roots of unity of all
+ * power of two orders up to 2^32, and allows a cheap reduction. Coefficients
+ * are kept small enough that no term of the convolution reaches the prime, so
+ * the product is exact. This takes O(n log n) time, rather than the O(n^1.46)
+ * of libtommath's Toom-Cook, and so wins for operands of many thousands of
+ * digits. */
+
+#define NTT_PRIME          ((MVMuint64)0xFFFFFFFF00000001ULL)
+#define NTT_EPSILON        ((MVMuint64)0xFFFFFFFFULL) /* 2^64 mod NTT_PRIME */
+#define NTT_GENERATOR      7
+#define NTT_MAX_COEFF_BITS 24
+
+/* Reduces hi * 2^64 + lo modulo the prime, using that 2^64 is congruent to
+ * 2^32 - 1 and 2^96 to -1. */
+MVM_STATIC_INLINE MVMuint64 ntt_reduce(MVMuint64 lo, MVMuint64 hi) {
+    MVMuint64 hi_hi = hi >> 32;
+    MVMuint64 hi_lo = hi & 0xFFFFFFFF;
+    MVMuint64 t0    = lo - hi_hi;
+    MVMuint64 t1, t2;
+    if (lo < hi_hi)
+        t0 -= NTT_EPSILON;
+    t1 = hi_lo * NTT_EPSILON;
+    t2 = t0 + t1;
+    if (t2 < t1)
+        t2 += NTT_EPSILON;
+    return t2 >= NTT_PRIME ? t2 - NTT_PRIME : t2;
+}
+
+MVM_STATIC_INLINE MVMuint64 ntt_mul(MVMuint64 a, MVMuint64 b) {
+#ifdef __SIZEOF_INT128__
+    unsigned __int128 x = (unsigned __int128)a * b;
+    return ntt_reduce((MVMuint64)x, (MVMuint64)(x >> 64));
+#else
+    MVMuint64 a_lo = a & 0xFFFFFFFF, a_hi = a >> 32;
+    MVMuint64 b_lo = b & 0xFFFFFFFF, b_hi = b >> 32;
+    MVMuint64 ll   = a_lo * b_lo;
+    MVMuint64 lh   = a_lo * b_hi;
+    MVMuint64 hl   = a_hi * b_lo;
+    MVMuint64 mid  = (ll >> 32) + (lh & 0xFFFFFFFF) + (hl & 0xFFFFFFFF);
+    return ntt_reduce((ll & 0xFFFFFFFF) | (mid << 32),
+        a_hi * b_hi + (lh >> 32) + (hl >> 32) + (mid >> 32));
+#endif
+}
+
+MVM_STATIC_INLINE MVMuint64 ntt_add(MVMuint64 a, MVMuint64 b) {
+    MVMuint64 s = a + b;
+    if (s < a)
+        return s + NTT_EPSILON;
+    return s >= NTT_PRIME ? s - NTT_PRIME : s;
+}
+
+MVM_STATIC_INLINE MVMuint64 ntt_sub(MVMuint64 a, MVMuint64 b) {
+    MVMuint64 d = a - b;
+    return a < b ? d - NTT_EPSILON : d;
+}
+
+static MVMuint64 ntt_pow(MVMuint64 base, MVMuint64 exp) {
+    MVMuint64 result = 1;
+    while (exp) {
+        if (exp & 1)
+            result = ntt_mul(result, base);
+        base = ntt_mul(base, base);
+        exp >>= 1;
+    }
+    return result;
+}
+
+/* Builds the twiddle factors for a transform of size n with the specified
+ * root of unity. Those for the butterflies spanning half elements are kept
+ * at w[half ..  2 * half - 1], so each pass reads them in order. */
+static MVMuint64 * ntt_twiddles(MVMuint64 root, size_t n) {
+    MVMuint64 *w = MVM_malloc((n < 2 ? 2 : n) * sizeof(MVMuint64));
+    size_t     half, j;
+    w[0] = 0;
+    if (n < 2)
+        return w;
+    w[n / 2] = 1;
+    for (j = n / 2 + 1; j < n; j++)
+        w[j] = ntt_mul(w[j - 1], root);
+    for (half = n / 4; half >= 1; half >>= 1)
+        for (j = 0; j < half; j++)
+            w[half + j] = w[2 * half + 2 * j];
+    return w;
+}
+
+/* Decimation in frequency transform, taking coefficients in natural order
+ * and leaving them in bit-reversed order. */
+static void ntt_forward(MVMuint64 *a, size_t n, const MVMuint64 *w) {
+    size_t len;
+    for (len = n; len >= 2; len >>= 1) {
+        size_t           half = len / 2;
+        const MVMuint64 *tw   = w + half;
+        size_t           start, j;
+        for (start = 0; start < n; start += len) {
+            MVMuint64 *lo = a + start;
+            MVMuint64 *hi = lo + half;
+            for (j = 0; j < half; j++) {
+                MVMuint64 u = lo[j];
+                MVMuint64 v = hi[j];
+                lo[j] = ntt_add(u, v);
+                hi[j] = ntt_mul(ntt_sub(u, v), tw[j]);
+            }
+        }
+    }
+}
+
+/* Decimation in time transform, taking coefficients in bit-reversed order
+ * and leaving them in natural order; with inverse twiddles, this undoes
+ * ntt_forward up to a factor of n. */
+static void ntt_inverse(MVMuint64 *a, size_t n, const MVMuint64 *w) {
+    size_t len;
+    for (len = 2; len <= n; len <<= 1) {
+        size_t           half = len / 2;
+        const MVMuint64 *tw   = w + half;
+        size_t           start, j;
+        for (start = 0; start < n; start += len) {
+            MVMuint64 *lo = a + start;
+            MVMuint64 *hi = lo + half;
+            for (j = 0; j < half; j++) {
+                MVMuint64 u = lo[j];
+                MVMuint64 v = ntt_mul(hi[j], tw[j]);
+                lo[j] = ntt_add(u, v);
+                hi[j] = ntt_sub(u, v);
+            }
+        }
+    }
+}
+
+/* Cuts the magnitude of x into count coefficients of the specified number of
+ * bits, zero filling up to n coefficients. */
+static void to_coeffs(mp_int *x, MVMuint64 *coeffs, size_t count, size_t n, int bits) {
+    MVMuint64 mask = ((MVMuint64)1 << bits) - 1;
+    size_t    i;
+    for (i = 0; i < count; i++) {
+        size_t    pos    = i * bits;
+        size_t    digit  = pos / DIGIT_BIT;
+        int       offset = (int)(pos % DIGIT_BIT);
+        int       have   = 0;
+        MVMuint64 value  = 0;
+        while (have < bits && digit < (size_t)USED(x)) {
+            value  |= ((MVMuint64)DIGIT(x, digit) >> offset) << have;
+            have   += DIGIT_BIT - offset;
+            offset  = 0;
+            digit++;
+        }
+        coeffs[i] = value & mask;
+    }
+    for (; i < n; i++)
+        coeffs[i] = 0;
+}
+
+void MVM_bigint_ntt_mul(mp_int *a, mp_int *b, mp_int *c) {
+    size_t     a_bits = mp_count_bits(a);
+    size_t     b_bits = mp_count_bits(b);
+    int        negative = SIGN(a) != SIGN(b);
+    int        bits, log_n;
+    size_t     a_count, b_count, n, i, num_digits;
+    MVMuint64 *fa, *fb, *w, carry, mask, n_inverse, root;
+    mp_int     product;
+
+    if (a_bits == 0 || b_bits == 0) {
+        mp_zero(c);
+        return;
+    }
+
+    /* Pick the widest coefficients for which all terms of the convolution
+     * stay below 2^63, and so below the prime. */
+    for (bits = NTT_MAX_COEFF_BITS; ; bits--) {
+        size_t terms, log_terms = 0;
+        a_count = (a_bits + bits - 1) / bits;
+        b_count = (b_bits + bits - 1) / bits;
+        terms   = a_count < b_count ? a_count : b_count;
+        while (((size_t)1 << log_terms) < terms)
+            log_terms++;
+        if (2 * bits + log_terms <= 63)
+            break;
+    }
+    n     = 1;
+    log_n = 0;
+    while (n < a_count + b_count - 1) {
+        n <<= 1;
+        log_n++;
+    }
+
+    /* Transform the operands; squaring needs just the one transform. */
+    root = ntt_pow(NTT_GENERATOR, (NTT_PRIME - 1) >> log_n);
+    w    = ntt_twiddles(root, n);
+    fa   = MVM_malloc(n * sizeof(MVMuint64));
+    to_coeffs(a, fa, a_count, n, bits);
+    ntt_forward(fa, n, w);
+    if (a == b) {
+        fb = fa;
+    }
+    else {
+        fb = MVM_malloc(n * sizeof(MVMuint64));
+        to_coeffs(b, fb, b_count, n, bits);
+        ntt_forward(fb, n, w);
+    }
+    for (i = 0; i < n; i++)
+        fa[i] = ntt_mul(fa[i], fb[i]);
+    if (fb != fa)
+        MVM_free(fb);
+    MVM_free(w);
+
+    /* Transform back, using the inverse root. */
+    w = ntt_twiddles(ntt_pow(root, n - 1), n);
+    ntt_inverse(fa, n, w);
+    MVM_free(w);
+
+    /* Scale and carry the coefficients into the digits of the product. We
+     * build it apart from c, since c may be one of the operands. */
+    num_digits = (a_bits + b_bits) / DIGIT_BIT + 1;
+    mp_init_size(&product, (int)num_digits);
+    for (i = 0; i < num_digits; i++)
+        DIGIT(&product, i) = 0;
+    n_inverse = NTT_PRIME - ((NTT_PRIME - 1) >> log_n);
+    mask      = ((MVMuint64)1 << bits) - 1;
+    carry     = 0;
+    for (i = 0; i < a_count + b_count - 1 || carry; i++) {
+        MVMuint64 value  = carry;
+        size_t    pos    = i * bits;
+        size_t    digit  = pos / DIGIT_BIT;
+        int       offset = (int)(pos % DIGIT_BIT);
+        if (i < a_count + b_count - 1)
+            value += ntt_mul(fa[i], n_inverse);
+        carry  = value >> bits;
+        value &= mask;
+        while (value && digit < num_digits) {
+            DIGIT(&product, digit) |= (mp_digit)(value << offset) & MP_MASK;
+            value  >>= DIGIT_BIT - offset;
+            offset   = 0;
+            digit++;
+        }
+    }
+    MVM_free(fa);
+    product.used = (int)num_digits;
+    mp_clamp(&product);
+    if (negative)
+        mp_neg(&product, &product);
+    mp_exch(&product, c);
+    mp_clear(&product);
+}
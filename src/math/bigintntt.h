@@ -0,0 +1,6 @@
+/* The default size, in bits of the smaller operand, from which big integer
+ * multiplications are done by number theoretic transform. It can be changed
+ * with the MVM_BIGINT_NTT_THRESHOLD environment variable; 0 disables it. */
+#define MVM_BIGINT_NTT_DEFAULT_THRESHOLD 1048576
+
+void MVM_bigint_ntt_mul(mp_int *a, mp_int *b, mp_int *c);
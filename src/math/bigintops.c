@@ -131,6 +131,38 @@ static MVMP6bigintBody * get_bigint_body(MVMThreadContext *tc, MVMObject *obj) {
             "Can only perform big integer operations on concrete objects");
 }
 
+/* Multiplies big integers, by number theoretic transform once both are large
+ * enough for that to beat libtommath. */
+static void bigint_mul(MVMThreadContext *tc, mp_int *a, mp_int *b, mp_int *c) {
+    MVMuint32 threshold = tc->instance->bigint_ntt_threshold;
+    if (threshold && (MVMuint32)mp_count_bits(a) >= threshold
+            && (MVMuint32)mp_count_bits(b) >= threshold)
+        MVM_bigint_ntt_mul(a, b, c);
+    else
+        mp_mul(a, b, c);
+}
+
+/* Raises a big integer to a power by repeated squaring. libtommath's
+ * mp_expt_d does the same, but the large squarings at the end of a big power
+ * want to go through bigint_mul. */
+static void bigint_expt(MVMThreadContext *tc, mp_int *base, mp_digit exponent, mp_int *result) {
+    MVMuint32 threshold = tc->instance->bigint_ntt_threshold;
+    mp_digit  bit;
+    if (!threshold || exponent < 2 || (MVMuint64)mp_count_bits(base) * exponent < 2 * (MVMuint64)threshold) {
+        mp_expt_d(base, exponent, result);
+        return;
+    }
+    bit = 1;
+    while (bit <= exponent / 2)
+        bit <<= 1;
+    mp_copy(base, result);
+    for (bit >>= 1; bit; bit >>= 1) {
+        bigint_mul(tc, result, result, result);
+        if (exponent & bit)
+            bigint_mul(tc, result, base, result);
+    }
+}
+
 /* Checks if a bigint can be stored small. */
 static int can_be_smallint(const mp_int *i) {
     if (USED(i) != 1)
@@ -351,7 +383,7 @@ MVMObject * MVM_bigint_##opname(MVMThreadContext *tc, MVMObject *result_type, MV
     return result; \
 }
 
-#define MVM_BIGINT_BINARY_OP_SIMPLE(opname, SMALLINT_OP) \
+#define MVM_BIGINT_BINARY_OP_SIMPLE(opname, BIGINT_OP, SMALLINT_OP) \
 MVMObject * MVM_bigint_##opname(MVMThreadContext *tc, MVMObject *result_type, MVMObject *a, MVMObject *b) { \
     MVMP6bigintBody *ba, *bb, *bc; \
     MVMObject *result; \
@@ -372,7 +404,7 @@ MVMObject * MVM_bigint_##opname(MVMThreadContext *tc, MVMObject *result_type, MV
         ib = force_bigint(bb, tmp); \
         ic = MVM_malloc(sizeof(mp_int)); \
         mp_init(ic); \
-        mp_##opname(ia, ib, ic); \
+        BIGINT_OP; \
         store_bigint_result(bc, ic); \
         clear_temp_bigints(tmp, 2); \
         adjust_nursery(tc, bc); \
@@ -431,11 +463,62 @@ MVM_BIGINT_UNARY_OP(neg, { sb = -sa; })
 /* unused */
 /* MVM_BIGINT_UNARY_OP(sqrt) */
 
-MVM_BIGINT_BINARY_OP_SIMPLE(add, { sc = sa + sb; })
-MVM_BIGINT_BINARY_OP_SIMPLE(sub, { sc = sa - sb; })
-MVM_BIGINT_BINARY_OP_SIMPLE(mul, { sc = sa * sb; })
+MVM_BIGINT_BINARY_OP_SIMPLE(add, { mp_add(ia, ib, ic); }, { sc = sa + sb; })
+MVM_BIGINT_BINARY_OP_SIMPLE(sub, { mp_sub(ia, ib, ic); }, { sc = sa - sb; })
+MVM_BIGINT_BINARY_OP_SIMPLE(mul, { bigint_mul(tc, ia, ib, ic); }, { sc = sa * sb; })
 MVM_BIGINT_BINARY_OP(lcm)
 
+/* Variants of the above used by spesh when the result type is known to be a
+ * P6opaque boxing a P6bigint at the specified offset, with no initialization
+ * to run beyond that of the P6bigint, which store_int64_result covers.
+ *
+ * MVM_bigint_sp_box produces such a result for a value that fits in a
+ * smallint, taking it from the int cache or filling in a freshly made object
+ * directly rather than going through the REPR. JIT-compiled code does the
+ * checks and smallint arithmetic inline and calls only this, deopting to the
+ * generic op if the result does not fit.
+ *
+ * The ops themselves take the same fast path when both operands are of the
+ * result type and small, and the result fits in a smallint; otherwise they
+ * fall back to the full op. Since smallints are 32 bits, the native
+ * arithmetic cannot overflow. */
+MVMObject * MVM_bigint_sp_box(MVMThreadContext *tc, MVMObject *result_type,
+        MVMint64 value, MVMuint16 offset) {
+    MVMObject *result = MVM_intcache_get(tc, result_type, value);
+    if (!result) {
+        MVMP6bigintBody *body;
+        result = MVM_gc_allocate_object(tc, STABLE(result_type));
+        body   = (MVMP6bigintBody *)((char *)OBJECT_BODY(result) + offset);
+        store_int64_result(body, value);
+    }
+    return result;
+}
+
+#define MVM_BIGINT_SP_BINARY_OP(opname, SMALLINT_OP) \
+MVMObject * MVM_bigint_sp_##opname(MVMThreadContext *tc, MVMObject *result_type, \
+        MVMObject *a, MVMObject *b, MVMuint16 offset) { \
+    MVMSTable *st = STABLE(result_type); \
+    if (IS_CONCRETE(a) && IS_CONCRETE(b) && STABLE(a) == st && STABLE(b) == st) { \
+        char *da = (char *)MVM_p6opaque_real_data(tc, OBJECT_BODY(a)); \
+        char *db = (char *)MVM_p6opaque_real_data(tc, OBJECT_BODY(b)); \
+        MVMP6bigintBody *ba = (MVMP6bigintBody *)(da + offset); \
+        MVMP6bigintBody *bb = (MVMP6bigintBody *)(db + offset); \
+        if (!MVM_BIGINT_IS_BIG(ba) && !MVM_BIGINT_IS_BIG(bb)) { \
+            MVMint64 sc; \
+            MVMint64 sa = ba->u.smallint.value; \
+            MVMint64 sb = bb->u.smallint.value; \
+            SMALLINT_OP; \
+            if (MVM_IS_32BIT_INT(sc)) \
+                return MVM_bigint_sp_box(tc, result_type, sc, offset); \
+        } \
+    } \
+    return MVM_bigint_##opname(tc, result_type, a, b); \
+}
+
+MVM_BIGINT_SP_BINARY_OP(add, { sc = sa + sb; })
+MVM_BIGINT_SP_BINARY_OP(sub, { sc = sa - sb; })
+MVM_BIGINT_SP_BINARY_OP(mul, { sc = sa * sb; })
+
 MVMObject *MVM_bigint_gcd(MVMThreadContext *tc, MVMObject *result_type, MVMObject *a, MVMObject *b) {
     MVMP6bigintBody *ba = get_bigint_body(tc, a);
     MVMP6bigintBody *bb = get_bigint_body(tc, b);
@@ -672,7 +755,7 @@ MVMObject * MVM_bigint_pow(MVMThreadContext *tc, MVMObject *a, MVMObject *b,
             mp_int *ic = MVM_malloc(sizeof(mp_int));
             MVMP6bigintBody *resbody;
             mp_init(ic);
-            mp_expt_d(base, exponent_d, ic);
+            bigint_expt(tc, base, exponent_d, ic);
             r = MVM_repr_alloc_init(tc, int_type);
             resbody = get_bigint_body(tc, r);
             store_bigint_result(resbody, ic);
@@ -810,11 +893,224 @@ void MVM_bigint_expmod(MVMThreadContext *tc, MVMObject *result, MVMObject *a, MV
     adjust_nursery(tc, bd);
 }
 
+/* libtommath converts to and from a radix a digit at a time, which is
+ * quadratic in the length of the number. For large numbers, we instead
+ * divide and conquer: a number is split by a power of the radix into a high
+ * and a low half, which are converted separately, so the work is dominated
+ * by a few large multiplications or divisions. The powers used, which are
+ * the largest power of the radix that fits in an mp_digit squared over and
+ * over again, are computed once per conversion. Below the thresholds (tuned
+ * by benchmark), the digit at a time approach is faster. */
+#define RADIX_DC_TO_STR_THRESHOLD   40  /* mp digits */
+#define RADIX_DC_FROM_STR_THRESHOLD 800 /* radix digits */
+
+static const char radix_digit_chars[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+
+typedef struct {
+    /* For multiplying the powers. */
+    MVMThreadContext *tc;
+
+    /* powers[j] is chunk ^ (2 ^ j). */
+    mp_int   *powers;
+    int       num_powers;
+
+    /* The largest power of the radix fitting in an mp_digit, and how many
+     * radix digits that power covers. */
+    mp_digit  chunk;
+    size_t    chunk_digits;
+    int       radix;
+} RadixPowers;
+
+static void radix_powers_init(MVMThreadContext *tc, RadixPowers *rp, int radix) {
+    rp->tc           = tc;
+    rp->radix        = radix;
+    rp->chunk        = radix;
+    rp->chunk_digits = 1;
+    while (rp->chunk <= MP_MASK / radix) {
+        rp->chunk *= radix;
+        rp->chunk_digits++;
+    }
+    rp->powers     = NULL;
+    rp->num_powers = 0;
+}
+
+/* Makes sure we have powers covering at least the specified number of radix
+ * digits; returns the index of the largest power computed. */
+static int radix_powers_cover(RadixPowers *rp, size_t digits) {
+    while (rp->num_powers == 0 || (rp->chunk_digits << (rp->num_powers - 1)) < digits) {
+        rp->powers = MVM_realloc(rp->powers, (rp->num_powers + 1) * sizeof(mp_int));
+        mp_init(&rp->powers[rp->num_powers]);
+        if (rp->num_powers == 0)
+            mp_set(&rp->powers[0], rp->chunk);
+        else
+            bigint_mul(rp->tc, &rp->powers[rp->num_powers - 1], &rp->powers[rp->num_powers - 1],
+                &rp->powers[rp->num_powers]);
+        rp->num_powers++;
+    }
+    return rp->num_powers - 1;
+}
+
+static void radix_powers_destroy(RadixPowers *rp) {
+    int j;
+    for (j = 0; j < rp->num_powers; j++)
+        mp_clear(&rp->powers[j]);
+    MVM_free(rp->powers);
+}
+
+/* Writes the digits of a small non-negative number, a chunk at a time. If
+ * width is zero, writes no leading zeros (but writes "0" for zero), and
+ * otherwise writes exactly width digits. Returns the end of the output. */
+static char * to_radix_leaf(RadixPowers *rp, mp_int *n, size_t width, char *out) {
+    size_t  max_digits = width ? width : (size_t)mp_count_bits(n) + 1;
+    char   *reversed   = MVM_malloc(max_digits + rp->chunk_digits);
+    size_t  count      = 0;
+    mp_int  rest;
+    mp_init_copy(&rest, n);
+    while (!mp_iszero(&rest)) {
+        mp_digit chunk_value;
+        size_t   k;
+        mp_div_d(&rest, rp->chunk, &rest, &chunk_value);
+        for (k = 0; k < rp->chunk_digits; k++) {
+            reversed[count++] = radix_digit_chars[chunk_value % rp->radix];
+            chunk_value /= rp->radix;
+        }
+    }
+    mp_clear(&rest);
+    if (width) {
+        /* The last chunk may have left more leading zeros than we want. */
+        while (count < width)
+            reversed[count++] = '0';
+        count = width;
+    }
+    else {
+        while (count > 1 && reversed[count - 1] == '0')
+            count--;
+        if (count == 0)
+            reversed[count++] = '0';
+    }
+    while (count)
+        *out++ = reversed[--count];
+    MVM_free(reversed);
+    return out;
+}
+
+/* Writes the digits of a non-negative number less than the square of power
+ * level; see to_radix_leaf for the meaning of width. */
+static char * to_radix_dc(RadixPowers *rp, mp_int *n, int level, size_t width, char *out) {
+    size_t low_width;
+    mp_int high, low;
+    if (level < 0 || USED(n) <= RADIX_DC_TO_STR_THRESHOLD)
+        return to_radix_leaf(rp, n, width, out);
+    if (!width && mp_cmp_mag(n, &rp->powers[level]) == MP_LT)
+        return to_radix_dc(rp, n, level - 1, 0, out);
+    low_width = rp->chunk_digits << level;
+    mp_init(&high);
+    mp_init(&low);
+    mp_div(n, &rp->powers[level], &high, &low);
+    out = to_radix_dc(rp, &high, level - 1, width ? width - low_width : 0, out);
+    out = to_radix_dc(rp, &low, level - 1, low_width, out);
+    mp_clear(&high);
+    mp_clear(&low);
+    return out;
+}
+
+/* Converts a bigint to a NUL-terminated string in the specified radix,
+ * returning its length. */
+static char * bigint_to_radix(MVMThreadContext *tc, mp_int *i, int radix, int *len) {
+    char *buf;
+    if (USED(i) > RADIX_DC_TO_STR_THRESHOLD) {
+        RadixPowers rp;
+        mp_int      magnitude;
+        size_t      max_digits;
+        char       *out;
+        int         level;
+        radix_powers_init(tc, &rp, radix);
+        max_digits = (size_t)(mp_count_bits(i) * (log(2.0) / log((double)radix))) + 2;
+        level      = radix_powers_cover(&rp, (max_digits + 1) / 2);
+        buf        = MVM_malloc(max_digits + 2);
+        out        = buf;
+        if (SIGN(i) == MP_NEG)
+            *out++ = '-';
+        mp_init(&magnitude);
+        mp_abs(i, &magnitude);
+        out = to_radix_dc(&rp, &magnitude, level, 0, out);
+        *out = '\0';
+        mp_clear(&magnitude);
+        radix_powers_destroy(&rp);
+        *len = (int)(out - buf) + 1;
+    }
+    else {
+        mp_radix_size(i, radix, len);
+        buf = (char *) MVM_malloc(*len);
+        mp_toradix_n(i, buf, radix, *len);
+    }
+    return buf;
+}
+
+/* Sets result to the value of the specified run of digits, all of which are
+ * valid in the radix. */
+static void from_radix_leaf(RadixPowers *rp, const char *digits, size_t len, mp_int *result) {
+    size_t pos = 0;
+    mp_zero(result);
+    while (pos < len) {
+        size_t   take  = len - pos < rp->chunk_digits ? len - pos : rp->chunk_digits;
+        mp_digit scale = 1;
+        mp_digit value = 0;
+        size_t   k;
+        for (k = 0; k < take; k++) {
+            char c = digits[pos + k];
+            scale *= rp->radix;
+            value  = value * rp->radix + (c >= '0' && c <= '9' ? c - '0' : (c | 0x20) - 'a' + 10);
+        }
+        mp_mul_d(result, scale, result);
+        mp_add_d(result, value, result);
+        pos += take;
+    }
+}
+
+static void from_radix_dc(RadixPowers *rp, const char *digits, size_t len, int level, mp_int *result) {
+    size_t low_len;
+    mp_int low;
+    while (level >= 0 && (rp->chunk_digits << level) >= len)
+        level--;
+    if (level < 0 || len <= RADIX_DC_FROM_STR_THRESHOLD) {
+        from_radix_leaf(rp, digits, len, result);
+        return;
+    }
+    low_len = rp->chunk_digits << level;
+    from_radix_dc(rp, digits, len - low_len, level, result);
+    mp_init(&low);
+    from_radix_dc(rp, digits + len - low_len, low_len, level - 1, &low);
+    bigint_mul(rp->tc, result, &rp->powers[level], result);
+    mp_add(result, &low, result);
+    mp_clear(&low);
+}
+
+/* Reads a decimal number, as mp_read_radix does: an optional minus sign and
+ * then digits up to the first non-digit. */
+static void bigint_from_decimal(MVMThreadContext *tc, mp_int *i, const char *buf) {
+    const char *digits = buf[0] == '-' ? buf + 1 : buf;
+    size_t      len    = 0;
+    while (digits[len] >= '0' && digits[len] <= '9')
+        len++;
+    if (len > RADIX_DC_FROM_STR_THRESHOLD) {
+        RadixPowers rp;
+        radix_powers_init(tc, &rp, 10);
+        from_radix_dc(&rp, digits, len, radix_powers_cover(&rp, len / 2), i);
+        radix_powers_destroy(&rp);
+        if (digits != buf && !mp_iszero(i))
+            mp_neg(i, i);
+    }
+    else {
+        mp_read_radix(i, buf, 10);
+    }
+}
+
 void MVM_bigint_from_str(MVMThreadContext *tc, MVMObject *a, const char *buf) {
     MVMP6bigintBody *body = get_bigint_body(tc, a);
     mp_int *i = MVM_malloc(sizeof(mp_int));
     mp_init(i);
-    mp_read_radix(i, buf, 10);
+    bigint_from_decimal(tc, i, buf);
     adjust_nursery(tc, body);
     if (can_be_smallint(i)) {
         body->u.smallint.flag = MVM_BIGINT_32_FLAG;
@@ -834,9 +1130,7 @@ MVMString * MVM_bigint_to_str(MVMThreadContext *tc, MVMObject *a, int base) {
         int len;
         char *buf;
         MVMString *result;
-        mp_radix_size(i, base, &len);
-        buf = (char *) MVM_malloc(len);
-        mp_toradix_n(i, buf, base, len);
+        buf = bigint_to_radix(tc, i, base, &len);
         result = MVM_string_ascii_decode(tc, tc->instance->VMString, buf, len - 1);
         MVM_free(buf);
         return result;
@@ -16,6 +16,11 @@ MVMObject * MVM_bigint_pow(MVMThreadContext *tc, MVMObject *a, MVMObject *b,
 MVMObject * MVM_bigint_gcd(MVMThreadContext *tc, MVMObject *result, MVMObject *a, MVMObject *b);
 MVMObject * MVM_bigint_lcm(MVMThreadContext *tc, MVMObject *result_type, MVMObject *a, MVMObject *b);
 
+MVMObject * MVM_bigint_sp_box(MVMThreadContext *tc, MVMObject *result_type, MVMint64 value, MVMuint16 offset);
+MVMObject * MVM_bigint_sp_add(MVMThreadContext *tc, MVMObject *result_type, MVMObject *a, MVMObject *b, MVMuint16 offset);
+MVMObject * MVM_bigint_sp_sub(MVMThreadContext *tc, MVMObject *result_type, MVMObject *a, MVMObject *b, MVMuint16 offset);
+MVMObject * MVM_bigint_sp_mul(MVMThreadContext *tc, MVMObject *result_type, MVMObject *a, MVMObject *b, MVMuint16 offset);
+
 MVMObject * MVM_bigint_or(MVMThreadContext *tc, MVMObject *result, MVMObject *a, MVMObject *b);
 MVMObject * MVM_bigint_xor(MVMThreadContext *tc, MVMObject *result, MVMObject *a, MVMObject *b);
 MVMObject * MVM_bigint_and(MVMThreadContext *tc, MVMObject *result, MVMObject *a, MVMObject *b);
@@ -0,0 +1,7 @@
+/* Enough space for the shortest representation of any double, including
+ * sign, decimal point, exponent and a terminating NUL. */
+#define MVM_NUM_SHORTEST_BUFFER_SIZE 32
+
+size_t MVM_num_format_shortest(MVMnum64 n, char *buffer);
+MVMint32 MVM_num_from_decimal(MVMThreadContext *tc, MVMuint64 mantissa, MVMint64 exp10, MVMint32 negative,
+    MVMint32 truncated, MVMnum64 *result);
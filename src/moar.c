@@ -77,7 +77,8 @@ MVMInstance * MVM_vm_create_instance(void) {
          *spesh_osr_disable, *spesh_limit, *spesh_blocking;
     char *jit_log, *jit_disable, *jit_bytecode_dir;
     char *dynvar_log;
-    int init_stat;
+    char *bigint_ntt_threshold;
+    int init_stat, i;
 
     /* Set up instance data structure. */
     instance = MVM_calloc(1, sizeof(MVMInstance));
@@ -86,6 +87,10 @@ MVMInstance * MVM_vm_create_instance(void) {
     instance->main_thread = MVM_tc_create(NULL, instance);
     instance->main_thread->thread_id = 1;
 
+    /* Set up page-protection GC safepoints, if enabled. */
+    MVM_gc_safepoint_install_handler(instance);
+    MVM_gc_safepoint_thread_started(instance->main_thread);
+
     /* Next thread to be created gets ID 2 (the main thread got ID 1). */
     MVM_store(&instance->next_user_thread_id, 2);
 
@@ -126,6 +131,12 @@ MVMInstance * MVM_vm_create_instance(void) {
     /* Set up loaded compunits hash mutex. */
     init_mutex(instance->mutex_loaded_compunits, "loaded compunits");
 
+    /* Set up interned strings table. */
+    instance->string_interns = MVM_calloc(MVM_STRING_INTERN_STRIPES,
+        sizeof(MVMStringInternStripe));
+    for (i = 0; i < MVM_STRING_INTERN_STRIPES; i++)
+        init_mutex(instance->string_interns[i].mutex, "string interns");
+
     /* Set up container registry mutex. */
     init_mutex(instance->mutex_container_registry, "container registry");
 
@@ -247,6 +258,13 @@ MVMInstance * MVM_vm_create_instance(void) {
     }
     instance->jit_seq_nr = 0;
 
+    /* Big integer multiplication tuning. */
+    bigint_ntt_threshold = getenv("MVM_BIGINT_NTT_THRESHOLD");
+    if (bigint_ntt_threshold && strlen(bigint_ntt_threshold))
+        instance->bigint_ntt_threshold = (MVMuint32)strtoul(bigint_ntt_threshold, NULL, 10);
+    else
+        instance->bigint_ntt_threshold = MVM_BIGINT_NTT_DEFAULT_THRESHOLD;
+
     /* Spesh thread syncing. */
     init_mutex(instance->mutex_spesh_sync, "spesh sync");
     init_cond(instance->cond_spesh_sync, "spesh sync");
@@ -475,6 +493,9 @@ void MVM_vm_destroy_instance(MVMInstance *instance) {
     uv_mutex_destroy(&instance->mutex_loaded_compunits);
     MVM_HASH_DESTROY(hash_handle, MVMLoadedCompUnitName, instance->loaded_compunits);
 
+    /* Clean up interned strings. */
+    MVM_string_intern_destroy(instance);
+
     /* Clean up Container registry. */
     uv_mutex_destroy(&instance->mutex_container_registry);
     MVM_HASH_DESTROY(hash_handle, MVMContainerRegistry, instance->container_registry);
@@ -518,7 +539,7 @@ void MVM_vm_destroy_instance(MVMInstance *instance) {
 
     /* Clean up integer constant and string cache. */
     uv_mutex_destroy(&instance->mutex_int_const_cache);
-    MVM_free(instance->int_const_cache);
+    MVM_intcache_destroy(instance->main_thread, instance->int_const_cache);
     MVM_free(instance->int_to_str_cache);
 
     /* Clean up event loop starting mutex. */
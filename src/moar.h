@@ -93,6 +93,7 @@ MVM_PUBLIC const MVMint32 MVM_jit_support(void);
 #include "6model/6model.h"
 #include "gc/collect.h"
 #include "gc/debug.h"
+#include "gc/safepoint.h"
 #include "gc/wb.h"
 #include "core/threadcontext.h"
 #include "core/instance.h"
@@ -111,6 +112,7 @@ MVM_PUBLIC const MVMint32 MVM_jit_support(void);
 #include "core/hll.h"
 #include "core/loadbytecode.h"
 #include "math/num.h"
+#include "math/dtoa.h"
 #include "core/coerce.h"
 #include "core/ext.h"
 #ifdef HAVE_LIBFFI
@@ -160,11 +162,14 @@ MVM_PUBLIC const MVMint32 MVM_jit_support(void);
 #include "strings/decode_stream.h"
 #include "strings/ascii.h"
 #include "strings/parse_num.h"
+#include "strings/scan.h"
+#include "strings/search.h"
 #include "strings/utf8.h"
 #include "strings/utf8_c8.h"
 #include "strings/utf16.h"
 #include "strings/iter.h"
 #include "strings/ops.h"
+#include "strings/intern.h"
 #include "strings/unicode_gen.h"
 #include "strings/unicode.h"
 #include "strings/latin1.h"
@@ -182,6 +187,7 @@ MVM_PUBLIC const MVMint32 MVM_jit_support(void);
 #include "io/asyncsocket.h"
 #include "io/asyncsocketudp.h"
 #include "math/bigintops.h"
+#include "math/bigintntt.h"
 #include "mast/driver.h"
 #include "core/intcache.h"
 #include "core/fixedsizealloc.h"
@@ -10,3 +10,45 @@ MVMuint32 MVM_platform_cpu_count(void) {
 
     return count;
 }
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#ifdef _MSC_VER
+#include <intrin.h>
+static MVMuint32 detect_cpu_features(void) {
+    MVMuint32 features = 0;
+    int info[4];
+    __cpuid(info, 1);
+    if (info[3] & (1 << 26))
+        features |= MVM_CPU_FEATURE_SSE2;
+    /* AVX2 also needs the OS to save the YMM registers (OSXSAVE and XCR0). */
+    if ((info[2] & (1 << 27)) && (info[2] & (1 << 28)) && (_xgetbv(0) & 6) == 6) {
+        __cpuidex(info, 7, 0);
+        if (info[1] & (1 << 5))
+            features |= MVM_CPU_FEATURE_AVX2;
+    }
+    return features;
+}
+#else
+static MVMuint32 detect_cpu_features(void) {
+    MVMuint32 features = 0;
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("sse2"))
+        features |= MVM_CPU_FEATURE_SSE2;
+    if (__builtin_cpu_supports("avx2"))
+        features |= MVM_CPU_FEATURE_AVX2;
+    return features;
+}
+#endif
+#else
+static MVMuint32 detect_cpu_features(void) {
+    return 0;
+}
+#endif
+
+MVMuint32 MVM_platform_cpu_features(void) {
+    /* Racing threads will come up with the same answer, so no need to lock. */
+    static volatile MVMint32 features = -1;
+    if (features < 0)
+        features = (MVMint32)detect_cpu_features();
+    return (MVMuint32)features;
+}
@@ -2,3 +2,12 @@
  * May return 0 on error.
  */
 MVMuint32 MVM_platform_cpu_count(void);
+
+/* Instruction set extensions that we may choose to use at runtime. */
+#define MVM_CPU_FEATURE_SSE2    1
+#define MVM_CPU_FEATURE_AVX2    2
+
+/* Determines which of the above features the CPU we are running on (and the
+ * OS) supports. Detection is only done once.
+ */
+MVMuint32 MVM_platform_cpu_features(void);
@@ -131,6 +131,9 @@ static void instrument_graph(MVMThreadContext *tc, MVMSpeshGraph *g) {
             case MVM_OP_add_I:
             case MVM_OP_sub_I:
             case MVM_OP_mul_I:
+            case MVM_OP_sp_add_I:
+            case MVM_OP_sp_sub_I:
+            case MVM_OP_sp_mul_I:
             case MVM_OP_div_I:
             case MVM_OP_mod_I:
             case MVM_OP_neg_I:
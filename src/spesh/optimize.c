@@ -748,6 +748,42 @@ static void optimize_repr_op(MVMThreadContext *tc, MVMSpeshGraph *g, MVMSpeshBB
         }
 }
 
+/* Boxing a known int or num into a type that keeps a box of that value in
+ * its cache can just use the cached box. Returns non-zero if it did. */
+static MVMint32 optimize_box_constant(MVMThreadContext *tc, MVMSpeshGraph *g, MVMSpeshIns *ins) {
+    MVMSpeshFacts *value_facts = MVM_spesh_get_facts(tc, g, ins->operands[1]);
+    MVMSpeshFacts *type_facts  = MVM_spesh_get_facts(tc, g, ins->operands[2]);
+    MVMSpeshFacts *result_facts;
+    MVMObject     *cached;
+    if (!(value_facts->flags & MVM_SPESH_FACT_KNOWN_VALUE))
+        return 0;
+    if (!(type_facts->flags & MVM_SPESH_FACT_KNOWN_TYPE) || !(type_facts->flags & MVM_SPESH_FACT_TYPEOBJ)
+            || !type_facts->type)
+        return 0;
+    cached = ins->info->opcode == MVM_OP_box_i
+        ? MVM_intcache_get(tc, type_facts->type, value_facts->value.i)
+        : MVM_numcache_get(tc, type_facts->type, value_facts->value.n);
+    if (!cached)
+        return 0;
+
+    value_facts->usages--;
+    type_facts->usages--;
+    MVM_spesh_use_facts(tc, g, value_facts);
+    MVM_spesh_use_facts(tc, g, type_facts);
+    ins->info = MVM_op_get_op(MVM_OP_sp_getspeshslot);
+    ins->operands[1].lit_i16 = MVM_spesh_add_spesh_slot_try_reuse(tc, g, (MVMCollectable *)cached);
+
+    /* The result is no longer a box we can look through to its source, but
+     * is a known value. */
+    result_facts = MVM_spesh_get_facts(tc, g, ins->operands[0]);
+    result_facts->flags  &= ~MVM_SPESH_FACT_KNOWN_BOX_SRC;
+    result_facts->flags  |= MVM_SPESH_FACT_KNOWN_TYPE | MVM_SPESH_FACT_KNOWN_VALUE
+                          | MVM_SPESH_FACT_CONCRETE;
+    result_facts->type    = STABLE(cached)->WHAT;
+    result_facts->value.o = cached;
+    return 1;
+}
+
 /* smrt_strify and smrt_numify can turn into unboxes, but at least
  * for smrt_numify it's "complicated". Also, later when we know how
  * to put new invocations into spesh'd code, we could make direct
@@ -1867,9 +1903,17 @@ static void optimize_bb(MVMThreadContext *tc, MVMSpeshGraph *g, MVMSpeshBB *bb,
             break;
         case MVM_OP_box_i:
         case MVM_OP_box_n:
+            if (!optimize_box_constant(tc, g, ins))
+                optimize_repr_op(tc, g, bb, ins, 2);
+            break;
         case MVM_OP_box_s:
             optimize_repr_op(tc, g, bb, ins, 2);
             break;
+        case MVM_OP_add_I:
+        case MVM_OP_sub_I:
+        case MVM_OP_mul_I:
+            optimize_repr_op(tc, g, bb, ins, 3);
+            break;
         case MVM_OP_newexception:
         case MVM_OP_bindexmessage:
         case MVM_OP_bindexpayload:
@@ -2029,6 +2073,122 @@ static void second_pass(MVMThreadContext *tc, MVMSpeshGraph *g, MVMSpeshBB *bb)
         second_pass(tc, g, bb->children[i]);
 }
 
+/* Checks if the value in the specified register is the result of the given
+ * instruction, perhaps by way of a set. */
+static MVMint32 is_result_of(MVMThreadContext *tc, MVMSpeshGraph *g, MVMSpeshOperand o,
+        MVMSpeshIns *ins) {
+    MVMSpeshFacts *facts = get_facts_direct(tc, g, o);
+    if (facts->dead_writer || !facts->writer)
+        return 0;
+    if (facts->writer == ins)
+        return 1;
+    if (facts->writer->info->opcode == MVM_OP_set) {
+        facts = get_facts_direct(tc, g, facts->writer->operands[1]);
+        return !facts->dead_writer && facts->writer == ins;
+    }
+    return 0;
+}
+
+/* Finds the basic block that a PHI is in. */
+static MVMSpeshBB * phi_bb(MVMThreadContext *tc, MVMSpeshGraph *g, MVMSpeshIns *phi) {
+    MVMSpeshBB *bb = g->entry;
+    while (bb) {
+        MVMSpeshIns *ins = bb->first_ins;
+        while (ins && ins->info->opcode == MVM_SSA_PHI) {
+            if (ins == phi)
+                return bb;
+            ins = ins->next;
+        }
+        bb = bb->linear_next;
+    }
+    return NULL;
+}
+
+/* Inserts an instruction at the end of a basic block, but ahead of any
+ * branch that ends it. */
+static void insert_before_branch(MVMThreadContext *tc, MVMSpeshBB *bb, MVMSpeshIns *to_insert) {
+    MVMSpeshIns *last = bb->last_ins;
+    if (last) {
+        MVMuint16 i;
+        for (i = 0; i < last->info->num_operands; i++) {
+            if ((last->info->operands[i] & MVM_operand_type_mask) == MVM_operand_ins) {
+                last = last->prev;
+                break;
+            }
+        }
+    }
+    MVM_spesh_manipulate_insert_ins(tc, bb, last, to_insert);
+}
+
+/* Looks for concatenations that accumulate a string in a loop; that is, the
+ * left operand comes from a PHI that the result flows back into. Done with
+ * concat_s, each iteration may copy everything so far, so instead we build
+ * the string up in a StringBuilder. The builder is created on the way into
+ * the loop and lives in a temporary that we never release, so nothing else
+ * can be put in that register while the loop runs. The op checks it is
+ * continuing on from its own last result, so it is fine if our guess about
+ * the loop is wrong. A loop entered by OSR skips creating the builder; the
+ * op then just concatenates. */
+static void optimize_concat_accum(MVMThreadContext *tc, MVMSpeshGraph *g) {
+    MVMSpeshBB *bb = g->entry;
+    while (bb) {
+        MVMSpeshIns *ins = bb->first_ins;
+        while (ins) {
+            if (ins->info->opcode == MVM_OP_concat_s) {
+                MVMSpeshFacts *facts = get_facts_direct(tc, g, ins->operands[1]);
+                MVMSpeshIns   *phi   = facts->dead_writer ? NULL : facts->writer;
+                MVMSpeshBB    *loop  = phi && phi->info->opcode == MVM_SSA_PHI
+                    ? phi_bb(tc, g, phi)
+                    : NULL;
+                MVMSpeshBB    *preheader = NULL;
+                MVMint32       accumulates = 0, entries = 0, i;
+
+                /* Need the concatenation's result to flow back into the PHI,
+                 * and exactly one other way into the loop besides OSR. */
+                if (loop) {
+                    for (i = 1; i < phi->info->num_operands; i++) {
+                        if (is_result_of(tc, g, phi->operands[i], ins)) {
+                            accumulates = 1;
+                        }
+                        else if (loop->pred[i - 1] != g->entry) {
+                            preheader = loop->pred[i - 1];
+                            entries++;
+                        }
+                    }
+                }
+                if (accumulates && entries == 1 && preheader != loop && !preheader->jumplist) {
+                    MVMSpeshOperand *orig_o  = ins->operands;
+                    MVMObject       *type    = tc->instance->StringBuilder;
+                    MVMSTable       *st      = STABLE(type);
+                    MVMSpeshIns     *create  = MVM_spesh_alloc(tc, g, sizeof(MVMSpeshIns));
+                    MVMSpeshOperand  builder = MVM_spesh_manipulate_get_temp_reg(tc, g, MVM_reg_obj);
+                    MVMSpeshFacts   *builder_facts;
+
+                    create->info                 = MVM_op_get_op(MVM_OP_sp_fastcreate);
+                    create->operands             = MVM_spesh_alloc(tc, g, 3 * sizeof(MVMSpeshOperand));
+                    create->operands[0]          = builder;
+                    create->operands[1].lit_i16  = st->size;
+                    create->operands[2].lit_i16  = MVM_spesh_add_spesh_slot(tc, g, (MVMCollectable *)st);
+                    insert_before_branch(tc, preheader, create);
+
+                    builder_facts          = get_facts_direct(tc, g, builder);
+                    builder_facts->writer  = create;
+                    builder_facts->flags  |= MVM_SPESH_FACT_KNOWN_TYPE | MVM_SPESH_FACT_CONCRETE;
+                    builder_facts->type    = type;
+                    builder_facts->usages++;
+
+                    ins->info        = MVM_op_get_op(MVM_OP_sp_concat_accum);
+                    ins->operands    = MVM_spesh_alloc(tc, g, 4 * sizeof(MVMSpeshOperand));
+                    memcpy(ins->operands, orig_o, 3 * sizeof(MVMSpeshOperand));
+                    ins->operands[3] = builder;
+                }
+            }
+            ins = ins->next;
+        }
+        bb = bb->linear_next;
+    }
+}
+
 /* Eliminates any unreachable basic blocks (that is, dead code). Not having
  * to consider them any further simplifies all that follows. */
 static void mark_handler_unreachable(MVMThreadContext *tc, MVMSpeshGraph *g, MVMint32 index) {
@@ -2180,5 +2340,6 @@ void MVM_spesh_optimize(MVMThreadContext *tc, MVMSpeshGraph *g, MVMSpeshPlanned
     eliminate_unused_log_guards(tc, g);
     eliminate_pointless_gotos(tc, g);
     eliminate_dead_ins(tc, g);
+    optimize_concat_accum(tc, g);
     second_pass(tc, g, g->entry);
 }
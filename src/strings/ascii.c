@@ -24,6 +24,7 @@ MVMString * MVM_string_ascii_decode(MVMThreadContext *tc, const MVMObject *resul
         }
     }
     result->body.num_graphs = result_graphs;
+    MVM_string_narrow_storage(tc, result);
 
     return result;
 }
@@ -243,6 +243,7 @@ static MVMString * take_chars(MVMThreadContext *tc, MVMDecodeStream *ds, MVMint3
             }
         }
     }
+    MVM_string_narrow_storage(tc, result);
     return result;
 }
 MVMString * MVM_string_decodestream_get_chars(MVMThreadContext *tc, MVMDecodeStream *ds,
@@ -360,10 +361,138 @@ static MVMint32 find_separator(MVMThreadContext *tc, const MVMDecodeStream *ds,
     }
     return 0;
 }
+
+/* Tries to get a line by scanning the undecoded bytes for a separator, then
+ * decoding just the bytes of the line straight into a string, without going
+ * through the decoded char buffers. This is possible when nothing is waiting
+ * in those buffers or in the normalizer, the encoding is ASCII-compatible,
+ * and the separators are all single bytes in it. Since a grapheme may extend
+ * over an ASCII char if it is next to a non-ASCII one, a separator that is
+ * not a control char needs ASCII either side of it; we give up if we can't
+ * tell that. Returns NULL, leaving the stream untouched, if the line can't
+ * be got this way. */
+static MVMString * get_until_sep_from_bytes(MVMThreadContext *tc, MVMDecodeStream *ds,
+                                            MVMDecodeStreamSeparators *sep_spec, MVMint32 chomp) {
+    MVMDecodeStreamBytes *cur_bytes;
+    MVMString *result;
+    char      *line;
+    MVMint64   line_length;
+    MVMint32   start, found, sep_bytes;
+    MVMuint8   sep;
+
+    if (!sep_spec->byte_seps || ds->chars_head || !ds->bytes_head)
+        return NULL;
+    if (!MVM_unicode_normalizer_empty(tc, &(ds->norm)) || ds->norm.translate_newlines)
+        return NULL;
+    switch (ds->encoding) {
+        case MVM_encoding_type_utf8:
+        case MVM_encoding_type_ascii:
+        case MVM_encoding_type_latin1:
+        case MVM_encoding_type_windows1252:
+            break;
+        default:
+            return NULL;
+    }
+
+    /* Scan the buffers for a separator byte. */
+    cur_bytes   = ds->bytes_head;
+    start       = ds->bytes_head_pos;
+    line_length = 0;
+    found       = -1;
+    while (cur_bytes) {
+        size_t skip = MVM_string_scan_byte_set((MVMuint8 *)cur_bytes->bytes + start,
+            cur_bytes->length - start, sep_spec->byte_seps, 0);
+        if (start + (MVMint64)skip < cur_bytes->length) {
+            found = start + (MVMint32)skip;
+            line_length += skip + 1;
+            break;
+        }
+        line_length += cur_bytes->length - start;
+        cur_bytes = cur_bytes->next;
+        start = 0;
+    }
+    if (found < 0 || line_length > 0x7FFFFFFF)
+        return NULL;
+
+    /* Get the line's bytes in one place; usually they already are. */
+    if (cur_bytes == ds->bytes_head) {
+        line = ds->bytes_head->bytes + ds->bytes_head_pos;
+    }
+    else {
+        MVMDecodeStreamBytes *copy_bytes = ds->bytes_head;
+        MVMint64 copied = 0;
+        line = MVM_malloc(line_length);
+        while (copy_bytes != cur_bytes) {
+            MVMint32 from = copy_bytes == ds->bytes_head ? ds->bytes_head_pos : 0;
+            memcpy(line + copied, copy_bytes->bytes + from, copy_bytes->length - from);
+            copied += copy_bytes->length - from;
+            copy_bytes = copy_bytes->next;
+        }
+        memcpy(line + copied, cur_bytes->bytes, found + 1);
+    }
+
+    /* Check the separator really is a grapheme by itself. */
+    sep = (MVMuint8)line[line_length - 1];
+    sep_bytes = 1;
+    if (sep == '\n' && line_length >= 2 && line[line_length - 2] == '\r') {
+        if (!sep_spec->byte_seps_crlf)
+            goto give_up;
+        sep_bytes = 2;
+    }
+    else if (sep >= 0x20 && sep != 0x7F) {
+        MVMuint8 next;
+        if (line_length >= 2 && (MVMuint8)line[line_length - 2] >= 0x80)
+            goto give_up;
+        if (found + 1 < cur_bytes->length)
+            next = (MVMuint8)cur_bytes->bytes[found + 1];
+        else if (cur_bytes->next && cur_bytes->next->length)
+            next = (MVMuint8)cur_bytes->next->bytes[0];
+        else
+            goto give_up;
+        if (next >= 0x80)
+            goto give_up;
+    }
+
+    /* Decode the line, and consume its bytes. */
+    if (chomp)
+        line_length -= sep_bytes;
+    switch (ds->encoding) {
+        case MVM_encoding_type_utf8:
+            result = ds->abs_byte_pos == 0
+                ? MVM_string_utf8_decode_strip_bom(tc, tc->instance->VMString, line, line_length)
+                : MVM_string_utf8_decode(tc, tc->instance->VMString, line, line_length);
+            break;
+        case MVM_encoding_type_ascii:
+            result = MVM_string_ascii_decode(tc, tc->instance->VMString, line, line_length);
+            break;
+        case MVM_encoding_type_latin1:
+            result = MVM_string_latin1_decode(tc, tc->instance->VMString, line, line_length);
+            break;
+        default:
+            result = MVM_string_windows1252_decode(tc, tc->instance->VMString, line, line_length);
+            break;
+    }
+    if (cur_bytes != ds->bytes_head)
+        MVM_free(line);
+    MVM_string_decodestream_discard_to(tc, ds, cur_bytes, found + 1);
+    return result;
+
+  give_up:
+    if (cur_bytes != ds->bytes_head)
+        MVM_free(line);
+    return NULL;
+}
+
 MVMString * MVM_string_decodestream_get_until_sep(MVMThreadContext *tc, MVMDecodeStream *ds,
                                                   MVMDecodeStreamSeparators *sep_spec, MVMint32 chomp) {
     MVMint32 sep_loc, sep_length;
 
+    /* Most lines can be found and decoded without decoding chars ahead of
+     * the separator; try that first. */
+    MVMString *from_bytes = get_until_sep_from_bytes(tc, ds, sep_spec, chomp);
+    if (from_bytes)
+        return from_bytes;
+
     /* Look for separator, trying more decoding if it fails. We get the place
      * just beyond the separator, so can use take_chars to get what's need.
      * Note that decoders are only responsible for finding the final char of
@@ -473,6 +602,7 @@ static MVMString * get_all_in_buffer(MVMThreadContext *tc, MVMDecodeStream *ds)
         ds->chars_head = ds->chars_tail = NULL;
     }
 
+    MVM_string_narrow_storage(tc, result);
     return result;
 }
 
@@ -593,6 +723,47 @@ void MVM_string_decodestream_destroy(MVMThreadContext *tc, MVMDecodeStream *ds)
     MVM_free(ds);
 }
 
+/* Works out if the separators can be found by scanning undecoded bytes, and
+ * if so sets up the set of bytes to look for. */
+static void cache_byte_seps(MVMThreadContext *tc, MVMDecodeStreamSeparators *sep_spec) {
+    MVMGrapheme32 crlf = MVM_nfg_crlf_grapheme(tc);
+    MVMByteSet *set = MVM_calloc(1, sizeof(MVMByteSet));
+    MVMint32 have_lf = 0;
+    MVMint32 have_crlf = 0;
+    MVMint32 cur_sep_pos = 0;
+    MVMint32 i;
+    for (i = 0; i < sep_spec->num_seps; i++) {
+        MVMint32 length = sep_spec->sep_lengths[i];
+        MVMGrapheme32 g;
+        cur_sep_pos += length;
+        if (length != 1)
+            goto unusable;
+        g = sep_spec->sep_graphemes[cur_sep_pos - 1];
+        if (g == crlf) {
+            have_crlf = 1;
+        }
+        else if (g >= 0 && g < 0x80 && g != '\r') {
+            set->bits[g >> 3] |= 1 << (g & 7);
+            if (g == '\n')
+                have_lf = 1;
+        }
+        else {
+            goto unusable;
+        }
+    }
+    if (sep_spec->num_seps == 0 || (have_crlf && !have_lf))
+        goto unusable;
+    MVM_string_byte_set_init(set);
+    sep_spec->byte_seps = set;
+    sep_spec->byte_seps_crlf = have_crlf;
+    return;
+
+  unusable:
+    MVM_free(set);
+    sep_spec->byte_seps = NULL;
+    sep_spec->byte_seps_crlf = 0;
+}
+
 /* Calculates and caches various bits of information about separators, for
  * faster line reading. */
 static void cache_sep_info(MVMThreadContext *tc, MVMDecodeStreamSeparators *sep_spec) {
@@ -613,6 +784,7 @@ static void cache_sep_info(MVMThreadContext *tc, MVMDecodeStreamSeparators *sep_
     sep_spec->max_sep_length = max_sep_length;
     sep_spec->final_graphemes = final_graphemes;
     sep_spec->max_final_grapheme = max_final_grapheme;
+    cache_byte_seps(tc, sep_spec);
 }
 
 /* Sets a decode stream separator to its default value. */
@@ -642,6 +814,7 @@ void MVM_string_decode_stream_sep_from_strings(MVMThreadContext *tc, MVMDecodeSt
     MVM_free(sep_spec->sep_lengths);
     MVM_free(sep_spec->sep_graphemes);
     MVM_free(sep_spec->final_graphemes);
+    MVM_free(sep_spec->byte_seps);
 
     sep_spec->num_seps = num_seps;
     sep_spec->sep_lengths = MVM_malloc(num_seps * sizeof(MVMint32));
@@ -669,4 +842,5 @@ void MVM_string_decode_stream_sep_from_strings(MVMThreadContext *tc, MVMDecodeSt
 void MVM_string_decode_stream_sep_destroy(MVMThreadContext *tc, MVMDecodeStreamSeparators *sep_spec) {
     MVM_free(sep_spec->sep_lengths);
     MVM_free(sep_spec->sep_graphemes);
+    MVM_free(sep_spec->byte_seps);
 }
@@ -78,6 +78,14 @@ struct MVMDecodeStreamSeparators {
      * maximum codepoint/synthetic index of any final grapheme and doing a
      * quick comparison. */
     MVMGrapheme32 max_final_grapheme;
+
+    /* If every separator is a single grapheme that is also a single byte in
+     * all of the ASCII-compatible encodings, the set of those bytes, so that
+     * lines can be found by scanning the undecoded bytes; NULL otherwise. A
+     * CRLF separator is allowed if \n is also a separator, and is found by
+     * way of the \n. */
+    MVMByteSet *byte_seps;
+    MVMint32    byte_seps_crlf;
 };
 
 /* Checks if we may have encountered one of the separators. This just looks to
@@ -0,0 +1,79 @@
+#include "moar.h"
+
+/* Interns a string. If an interned string with the same content already
+ * exists, that is returned; otherwise the string itself is interned and
+ * returned. Interned strings are unique by content, so two of them are equal
+ * exactly when they are the same object. The table does not keep them alive;
+ * MVM_string_intern_purge drops those that died. Strand strings and long
+ * strings are returned as they are, without being interned. */
+MVMString * MVM_string_intern(MVMThreadContext *tc, MVMString *s) {
+    MVMStringInternStripe *stripe;
+    MVMStringInternEntry  *entry;
+
+    if (s->body.interned || s->body.storage_type == MVM_STRING_STRAND
+            || s->body.num_graphs > MVM_STRING_INTERN_MAX_GRAPHS)
+        return s;
+
+    if (!s->body.cached_hash_code)
+        MVM_string_compute_hash_code(tc, s);
+    stripe = &tc->instance->string_interns[
+        (s->body.cached_hash_code >> 16) & (MVM_STRING_INTERN_STRIPES - 1)];
+
+    /* We may have to wait for the lock while another thread starts a GC, so
+     * mark ourselves blocked. Nothing in here allocates, so no GC can happen
+     * while we hold it. */
+    MVMROOT(tc, s, {
+        MVM_gc_mark_thread_blocked(tc);
+        uv_mutex_lock(&stripe->mutex);
+        MVM_gc_mark_thread_unblocked(tc);
+    });
+    MVM_HASH_GET(tc, stripe->entries, s, entry);
+    if (entry) {
+        s = MVM_HASH_KEY(entry);
+    }
+    else {
+        entry = MVM_calloc(1, sizeof(MVMStringInternEntry));
+        s->body.interned = 1;
+        MVM_HASH_BIND(tc, stripe->entries, s, entry);
+    }
+    uv_mutex_unlock(&stripe->mutex);
+
+    return s;
+}
+
+/* Called by the GC co-ordinator once marking is done, with the world
+ * stopped. Drops interned strings that were not marked, and updates those
+ * that were moved. For a nursery collection, strings in the second
+ * generation were not marked and are left alone. */
+void MVM_string_intern_purge(MVMThreadContext *tc, MVMuint8 gen) {
+    MVMuint32 i;
+    for (i = 0; i < MVM_STRING_INTERN_STRIPES; i++) {
+        MVMStringInternStripe *stripe = &tc->instance->string_interns[i];
+        MVMStringInternEntry  *current, *tmp;
+        unsigned               bucket_tmp;
+        HASH_ITER(hash_handle, stripe->entries, current, tmp, bucket_tmp) {
+            MVMCollectable *key   = (MVMCollectable *)current->hash_handle.key;
+            MVMuint32       flags = key->flags;
+            if (gen != MVMGCGenerations_Both && (flags & MVM_CF_SECOND_GEN))
+                continue;
+            if (flags & MVM_CF_FORWARDER_VALID) {
+                current->hash_handle.key = key->sc_forward_u.forwarder;
+            }
+            else if (!(flags & MVM_CF_GEN2_LIVE)) {
+                HASH_DELETE(hash_handle, stripe->entries, current);
+                MVM_free(current);
+            }
+        }
+    }
+}
+
+/* Frees the table of interned strings. */
+void MVM_string_intern_destroy(MVMInstance *instance) {
+    MVMuint32 i;
+    for (i = 0; i < MVM_STRING_INTERN_STRIPES; i++) {
+        MVMStringInternStripe *stripe = &instance->string_interns[i];
+        uv_mutex_destroy(&stripe->mutex);
+        MVM_HASH_DESTROY(hash_handle, MVMStringInternEntry, stripe->entries);
+    }
+    MVM_free(instance->string_interns);
+}
@@ -0,0 +1,24 @@
+/* Strings longer than this many graphemes are not worth interning; the
+ * interned strings are meant to be names and the like. */
+#define MVM_STRING_INTERN_MAX_GRAPHS 128
+
+/* The number of separately locked parts the table of interned strings is
+ * split into, chosen between by hash code. Must be a power of 2. */
+#define MVM_STRING_INTERN_STRIPES 16
+
+/* An entry in the VM-wide table of interned strings. The string itself is
+ * the hash key. */
+struct MVMStringInternEntry {
+    /* Inline handle to the interned strings hash. */
+    UT_hash_handle hash_handle;
+};
+
+/* One part of the table of interned strings, with its own lock. */
+struct MVMStringInternStripe {
+    MVMStringInternEntry *entries;
+    uv_mutex_t            mutex;
+};
+
+MVMString * MVM_string_intern(MVMThreadContext *tc, MVMString *s);
+void MVM_string_intern_purge(MVMThreadContext *tc, MVMuint8 gen);
+void MVM_string_intern_destroy(MVMInstance *instance);
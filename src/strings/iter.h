@@ -104,6 +104,36 @@ MVM_STATIC_INLINE void MVM_string_gi_move_to(MVMThreadContext *tc, MVMGraphemeIt
     }
 }
 
+/* Finds the strand of a strand string that holds the specified position. */
+MVMuint16 MVM_string_find_strand(MVMThreadContext *tc, MVMString *s, MVMStringIndex pos,
+    MVMStringIndex *strand_start);
+
+/* Initializes a grapheme iterator at the specified position. For strand
+ * strings with many strands, this goes straight to the strand holding the
+ * position, rather than walking over all of those before it. */
+MVM_STATIC_INLINE void MVM_string_gi_init_at(MVMThreadContext *tc, MVMGraphemeIter *gi,
+        MVMString *s, MVMStringIndex pos) {
+    if (s->body.storage_type == MVM_STRING_STRAND
+            && s->body.num_strands >= MVM_STRING_STRAND_INDEX_MIN) {
+        MVMStringIndex   strand_start;
+        MVMuint16        i      = MVM_string_find_strand(tc, s, pos, &strand_start);
+        MVMStringStrand *strand = s->body.storage.strands + i;
+        gi->active_blob.any   = strand->blob_string->body.storage.any;
+        gi->blob_type         = strand->blob_string->body.storage_type;
+        gi->strands_remaining = s->body.num_strands - 1 - i;
+        gi->pos               = strand->start;
+        gi->end               = strand->end;
+        gi->start             = strand->start;
+        gi->repetitions       = strand->repetitions;
+        gi->next_strand       = strand + 1;
+        MVM_string_gi_move_to(tc, gi, pos - strand_start);
+    }
+    else {
+        MVM_string_gi_init(tc, gi, s);
+        MVM_string_gi_move_to(tc, gi, pos);
+    }
+}
+
 /* Checks if there is more to read from a grapheme iterator. */
 MVM_STATIC_INLINE MVMint32 MVM_string_gi_has_more(MVMThreadContext *tc, MVMGraphemeIter *gi) {
     return gi->pos < gi->end || gi->repetitions || gi->strands_remaining;
@@ -12,29 +12,28 @@ MVMString * MVM_string_latin1_decode(MVMThreadContext *tc, const MVMObject *resu
     MVMuint8 writing_32bit = 0;
 
     result->body.storage_type   = MVM_STRING_GRAPHEME_8;
-    result->body.storage.blob_8 = MVM_malloc(sizeof(MVMint8) * bytes);
+    result->body.storage.blob_8 = MVM_malloc(sizeof(MVMGrapheme8) * bytes);
 
+    /* Every byte is a grapheme in its own right that fits in 8-bit storage,
+     * except that \r\n is the synthetic CRLF grapheme, which does not. */
     result_graphs = 0;
     for (i = 0; i < bytes; i++) {
         if (latin1[i] == '\r' && i + 1 < bytes && latin1[i + 1] == '\n') {
-            if (writing_32bit)
-                result->body.storage.blob_32[result_graphs++] = MVM_nfg_crlf_grapheme(tc);
-            else
-                result->body.storage.blob_8[result_graphs++] = MVM_nfg_crlf_grapheme(tc);
-            i++;
-        }
-        else {
-            if (latin1[i] > 127 && !writing_32bit) {
+            if (!writing_32bit) {
                 MVMGrapheme8 *old_storage = result->body.storage.blob_8;
 
                 result->body.storage.blob_32 = MVM_malloc(sizeof(MVMGrapheme32) * bytes);
                 result->body.storage_type = MVM_STRING_GRAPHEME_32;
                 writing_32bit = 1;
 
-                for (k = 0; k < i; k++)
+                for (k = 0; k < result_graphs; k++)
                     result->body.storage.blob_32[k] = old_storage[k];
                 MVM_free(old_storage);
             }
+            result->body.storage.blob_32[result_graphs++] = MVM_nfg_crlf_grapheme(tc);
+            i++;
+        }
+        else {
             if (writing_32bit)
                 result->body.storage.blob_32[result_graphs++] = latin1[i];
             else
@@ -150,6 +149,11 @@ char * MVM_string_latin1_encode_substr(MVMThreadContext *tc, MVMString *str, MVM
     size_t result_alloc;
     MVMuint8 *repl_bytes = NULL;
     MVMuint64 repl_length;
+#ifdef _WIN32
+    MVMint32 can_copy_8bit = !translate_newlines;
+#else
+    MVMint32 can_copy_8bit = 1;
+#endif
 
     /* must check start first since it's used in the length check */
     if (start < 0 || start > strgraphs)
@@ -170,6 +174,13 @@ char * MVM_string_latin1_encode_substr(MVMThreadContext *tc, MVMString *str, MVM
         if (output_size)
             *output_size = lengthu;
     }
+    else if (str->body.storage_type == MVM_STRING_GRAPHEME_8 && can_copy_8bit) {
+        /* 8-bit storage is Latin-1 already. */
+        memcpy(result, str->body.storage.blob_8 + startu, lengthu);
+        result[lengthu] = 0;
+        if (output_size)
+            *output_size = lengthu;
+    }
     else {
         MVMuint32 i = 0;
         MVMCodepointIter ci;
@@ -356,17 +356,22 @@ MVM_STATIC_INLINE MVMint32 codepoint_GCB_Control (MVMThreadContext *tc, MVMCodep
 /* Returns non-zero if the result of concatenating the two strings will freely
  * leave us in NFG without any further effort. */
 MVMint32 MVM_nfg_is_concat_stable(MVMThreadContext *tc, MVMString *a, MVMString *b) {
-    MVMGrapheme32 last_a;
-    MVMGrapheme32 first_b;
-    MVMGrapheme32 crlf;
-
     /* If either string is empty, we're good. */
     if (a->body.num_graphs == 0 || b->body.num_graphs == 0)
         return 1;
 
-    /* Get first and last graphemes of the strings. */
-    last_a = MVM_string_get_grapheme_at_nocheck(tc, a, a->body.num_graphs - 1);
-    first_b = MVM_string_get_grapheme_at_nocheck(tc, b, 0);
+    /* Otherwise, it depends on the graphemes either side of the join. */
+    return MVM_nfg_is_concat_stable_graphemes(tc,
+        MVM_string_get_grapheme_at_nocheck(tc, a, a->body.num_graphs - 1),
+        MVM_string_get_grapheme_at_nocheck(tc, b, 0));
+}
+
+/* Returns non-zero if placing grapheme first_b straight after grapheme last_a
+ * will leave us in NFG without any further effort. */
+MVMint32 MVM_nfg_is_concat_stable_graphemes(MVMThreadContext *tc, MVMGrapheme32 last_a,
+        MVMGrapheme32 first_b) {
+    MVMGrapheme32 crlf;
+
     /* Put the case where we are adding a lf or crlf line ending */
     if (first_b == '\n')
         /* If we see \r + \n we need to renormalize. Otherwise we're good */
@@ -86,6 +86,8 @@ MVMGrapheme32 MVM_nfg_crlf_grapheme(MVMThreadContext *tc);
 MVMNFGSynthetic * MVM_nfg_get_synthetic_info(MVMThreadContext *tc, MVMGrapheme32 synth);
 MVMuint32 MVM_nfg_get_case_change(MVMThreadContext *tc, MVMGrapheme32 codepoint, MVMint32 case_, MVMGrapheme32 **result);
 MVMint32 MVM_nfg_is_concat_stable(MVMThreadContext *tc, MVMString *a, MVMString *b);
+MVMint32 MVM_nfg_is_concat_stable_graphemes(MVMThreadContext *tc, MVMGrapheme32 last_a,
+    MVMGrapheme32 first_b);
 
 /* NFG subsystem initialization and cleanup. */
 void MVM_nfg_init(MVMThreadContext *tc);
@@ -37,7 +37,7 @@ void MVM_unicode_normalize_codepoints(MVMThreadContext *tc, const MVMObject *in,
     MVMNormalizer  norm;
     MVMCodepoint  *input;
     MVMCodepoint  *result;
-    MVMint64       input_pos, input_codes, result_pos, result_alloc;
+    MVMint64       input_codes, result_pos, result_alloc;
     MVMint32       ready;
 
     /* Validate input/output array. */
@@ -56,19 +56,9 @@ void MVM_unicode_normalize_codepoints(MVMThreadContext *tc, const MVMObject *in,
 
     /* Perform normalization. */
     MVM_unicode_normalizer_init(tc, &norm, form);
-    input_pos  = 0;
     result_pos = 0;
-    while (input_pos < input_codes) {
-        MVMCodepoint cp;
-        ready = MVM_unicode_normalizer_process_codepoint(tc, &norm, input[input_pos], &cp);
-        if (ready) {
-            maybe_grow_result(&result, &result_alloc, result_pos + ready);
-            result[result_pos++] = cp;
-            while (--ready > 0)
-                result[result_pos++] = MVM_unicode_normalizer_get_codepoint(tc, &norm);
-        }
-        input_pos++;
-    }
+    MVM_unicode_normalizer_process_codepoints(tc, &norm, input, input_codes,
+        &result, &result_alloc, &result_pos);
     MVM_unicode_normalizer_eof(tc, &norm);
     ready = MVM_unicode_normalizer_available(tc, &norm);
     maybe_grow_result(&result, &result_alloc, result_pos + ready);
@@ -83,7 +73,7 @@ void MVM_unicode_normalize_codepoints(MVMThreadContext *tc, const MVMObject *in,
 }
 MVMString * MVM_unicode_codepoints_c_array_to_nfg_string(MVMThreadContext *tc, MVMCodepoint * cp_v, MVMint64 cp_count) {
     MVMNormalizer  norm;
-    MVMint64       input_pos, result_pos, result_alloc;
+    MVMint64       result_pos, result_alloc;
     MVMGrapheme32 *result;
     MVMint32       ready;
     MVMString     *str;
@@ -97,19 +87,9 @@ MVMString * MVM_unicode_codepoints_c_array_to_nfg_string(MVMThreadContext *tc, M
 
     /* Perform normalization at grapheme level. */
     MVM_unicode_normalizer_init(tc, &norm, MVM_NORMALIZE_NFG);
-    input_pos  = 0;
     result_pos = 0;
-    while (input_pos < cp_count) {
-        MVMGrapheme32 g;
-        ready = MVM_unicode_normalizer_process_codepoint_to_grapheme(tc, &norm, cp_v[input_pos], &g);
-        if (ready) {
-            maybe_grow_result(&result, &result_alloc, result_pos + ready);
-            result[result_pos++] = g;
-            while (--ready > 0)
-                result[result_pos++] = MVM_unicode_normalizer_get_grapheme(tc, &norm);
-        }
-        input_pos++;
-    }
+    MVM_unicode_normalizer_process_codepoints(tc, &norm, cp_v, cp_count,
+        &result, &result_alloc, &result_pos);
     MVM_unicode_normalizer_eof(tc, &norm);
     ready = MVM_unicode_normalizer_available(tc, &norm);
     maybe_grow_result(&result, &result_alloc, result_pos + ready);
@@ -122,6 +102,7 @@ MVMString * MVM_unicode_codepoints_c_array_to_nfg_string(MVMThreadContext *tc, M
     str->body.storage.blob_32 = result;
     str->body.storage_type    = MVM_STRING_GRAPHEME_32;
     str->body.num_graphs      = result_pos;
+    MVM_string_narrow_storage(tc, str);
     return str;
 }
 
@@ -764,6 +745,85 @@ MVMint32 MVM_unicode_normalizer_process_codepoint_full(MVMThreadContext *tc, MVM
     return norm->buffer_norm_end - norm->buffer_start++;
 }
 
+/* Checks if a codepoint is stable: it is unchanged by normalization, and
+ * can neither combine with what comes before it nor have what comes after
+ * it combine with it. That's so if it passes quick check, has a CCC of zero
+ * and is a grapheme cluster break class of Other (which rules out prepends,
+ * extenders, controls, Hangul and so forth). Everything below the first
+ * significant codepoint is stable, apart from \r when we're making NFG. */
+static MVMint32 is_stable(MVMThreadContext *tc, const MVMNormalizer *n, MVMCodepoint cp) {
+    if (cp < n->first_significant)
+        return cp != 0x0D || !MVM_NORMALIZE_GRAPHEME(n->form);
+    return passes_quickcheck(tc, n, cp)
+        && MVM_unicode_relative_ccc(tc, cp) == 0
+        && MVM_unicode_codepoint_get_property_int(tc, cp,
+            MVM_UNICODE_PROPERTY_GRAPHEME_CLUSTER_BREAK) == MVM_UNICODE_PVALUE_GCB_OTHER;
+}
+
+/* Takes the longest run of stable codepoints from the start of the input,
+ * writing one normalized codepoint to out for each one taken, and returns
+ * how many were taken. When composing, this needs the normalizer to hold
+ * just a single, stable, codepoint; it is handed out first, and the last of
+ * the run is held in its place, since what follows may combine with it.
+ * When decomposing, the normalizer must be empty. If it is in any other
+ * state, nothing is taken and 0 is returned. */
+MVMint32 MVM_unicode_normalizer_process_stable_run(MVMThreadContext *tc, MVMNormalizer *n,
+        const MVMCodepoint *in, MVMint32 num_codepoints, MVMCodepoint *out) {
+    MVMint32 run = 0;
+    if (n->prepend_buffer || n->buffer_norm_end != n->buffer_start)
+        return 0;
+    if (MVM_NORMALIZE_COMPOSE(n->form)) {
+        if (n->buffer_end - n->buffer_start != 1 || !is_stable(tc, n, n->buffer[n->buffer_start]))
+            return 0;
+        while (run < num_codepoints && is_stable(tc, n, in[run]))
+            run++;
+        if (run) {
+            out[0] = n->buffer[n->buffer_start];
+            memcpy(out + 1, in, (run - 1) * sizeof(MVMCodepoint));
+            n->buffer[n->buffer_start] = in[run - 1];
+        }
+    }
+    else {
+        if (n->buffer_end != n->buffer_start)
+            return 0;
+        while (run < num_codepoints && is_stable(tc, n, in[run]))
+            run++;
+        memcpy(out, in, run * sizeof(MVMCodepoint));
+    }
+    return run;
+}
+
+/* Normalizes a buffer of codepoints, adding whatever becomes available to
+ * the end of *out, which holds *out_pos codepoints and has room for
+ * *out_alloc, growing it as needed. Runs of stable codepoints are copied
+ * through in bulk, so the normalizer proper only gets involved at their
+ * boundaries. */
+void MVM_unicode_normalizer_process_codepoints(MVMThreadContext *tc, MVMNormalizer *n,
+        const MVMCodepoint *in, MVMint64 num_codepoints, MVMCodepoint **out,
+        MVMint64 *out_alloc, MVMint64 *out_pos) {
+    MVMint64 i = 0;
+    while (i < num_codepoints) {
+        MVMCodepoint cp;
+        MVMint32 ready;
+        MVMint64 left = num_codepoints - i;
+        MVMint32 run;
+        maybe_grow_result(out, out_alloc, *out_pos + left);
+        run = MVM_unicode_normalizer_process_stable_run(tc, n, in + i,
+            left > 0x7FFFFFFF ? 0x7FFFFFFF : (MVMint32)left, *out + *out_pos);
+        *out_pos += run;
+        i        += run;
+        if (i == num_codepoints)
+            break;
+        ready = MVM_unicode_normalizer_process_codepoint(tc, n, in[i++], &cp);
+        if (ready) {
+            maybe_grow_result(out, out_alloc, *out_pos + ready);
+            (*out)[(*out_pos)++] = cp;
+            while (--ready > 0)
+                (*out)[(*out_pos)++] = MVM_unicode_normalizer_get_codepoint(tc, n);
+        }
+    }
+}
+
 /* Push a number of codepoints into the "to normalize" buffer. */
 void MVM_unicode_normalizer_push_codepoints(MVMThreadContext *tc, MVMNormalizer *n, const MVMCodepoint *in, MVMint32 num_codepoints) {
     MVMint32 i;
@@ -124,6 +124,34 @@ MVM_STATIC_INLINE MVMint32 MVM_unicode_normalizer_process_codepoint_to_grapheme(
     return MVM_unicode_normalizer_process_codepoint(tc, n, in, (MVMGrapheme32 *)out);
 }
 
+/* Processes a run of ASCII codepoints, none of them \r, when the normalizer
+ * holds nothing but one such codepoint, as it does part way through ASCII
+ * text. None of them can combine with their neighbours, so the one held and
+ * all but the last of the run are ready at once; they are written to out,
+ * the last of the run is held in their place, and the number written is
+ * returned. If the normalizer is not in that state, returns -1 and does
+ * nothing. */
+MVM_STATIC_INLINE MVMint32 MVM_unicode_normalizer_process_ascii_run(MVMThreadContext *tc, MVMNormalizer *n, const MVMuint8 *in, MVMint32 num_codepoints, MVMCodepoint *out) {
+    MVMint32 i;
+    if (num_codepoints < 1 || !MVM_NORMALIZE_COMPOSE(n->form) || n->prepend_buffer
+            || n->buffer_end - n->buffer_start != 1 || n->buffer_norm_end != n->buffer_start
+            || n->buffer[n->buffer_start] >= 0x80 || n->buffer[n->buffer_start] == 0x0D)
+        return -1;
+    out[0] = n->buffer[n->buffer_start];
+    for (i = 1; i < num_codepoints; i++)
+        out[i] = in[i - 1];
+    n->buffer[n->buffer_start] = in[num_codepoints - 1];
+    return num_codepoints;
+}
+
+/* Bulk processing of codepoints, taking runs of those that normalization
+ * cannot affect without going through the normalizer proper. */
+MVMint32 MVM_unicode_normalizer_process_stable_run(MVMThreadContext *tc, MVMNormalizer *n,
+    const MVMCodepoint *in, MVMint32 num_codepoints, MVMCodepoint *out);
+void MVM_unicode_normalizer_process_codepoints(MVMThreadContext *tc, MVMNormalizer *n,
+    const MVMCodepoint *in, MVMint64 num_codepoints, MVMCodepoint **out,
+    MVMint64 *out_alloc, MVMint64 *out_pos);
+
 /* Push a number of codepoints into the "to normalize" buffer. */
 void MVM_unicode_normalizer_push_codepoints(MVMThreadContext *tc, MVMNormalizer *n, const MVMCodepoint *in, MVMint32 num_codepoints);
 
@@ -1,4 +1,3 @@
-#include "platform/memmem.h"
 #include "moar.h"
 #define MVM_DEBUG_STRANDS 0
 
@@ -54,7 +53,7 @@ static void move_strands(MVMThreadContext *tc, const MVMString *from, MVMuint16
 }
 
 MVM_STATIC_INLINE int can_fit_into_8bit (MVMGrapheme32 g) {
-    return -128 <= g && g <= 127;
+    return 0 <= g && g <= 255;
 }
 MVM_STATIC_INLINE int can_fit_into_ascii (MVMGrapheme32 g) {
     return 0 <= g && g <= 127;
@@ -74,6 +73,18 @@ static void turn_32bit_into_8bit_unchecked(MVMThreadContext *tc, MVMString *str)
     MVM_free(old_buf);
 }
 
+/* If a string with 32-bit storage only holds graphemes that would fit in 8
+ * bits, switches it over to 8-bit storage. */
+void MVM_string_narrow_storage(MVMThreadContext *tc, MVMString *str) {
+    if (str->body.storage_type == MVM_STRING_GRAPHEME_32) {
+        MVMStringIndex i;
+        for (i = 0; i < str->body.num_graphs; i++)
+            if (!can_fit_into_8bit(str->body.storage.blob_32[i]))
+                return;
+        turn_32bit_into_8bit_unchecked(tc, str);
+    }
+}
+
 /* Accepts an allocated string that should have body.num_graphs set but the blob
  * unallocated. This function will allocate the space for the blob and iterate
  * the supplied grapheme iterator for the length of body.num_graphs */
@@ -85,8 +96,8 @@ static void iterate_gi_into_string(MVMThreadContext *tc, MVMGraphemeIter *gi, MV
         MVMGrapheme32 g = MVM_string_gi_get_grapheme(tc, gi);
         result->body.storage.blob_8[i] = g;
         if (!can_fit_into_8bit(g)) {
-            /* If we get here, we saw a codepoint lower than -127 or higher than 127
-             * so turn it into a 32 bit string instead */
+            /* If we get here, we saw a synthetic or a codepoint higher than
+             * 255 so turn it into a 32 bit string instead */
             /* Store the old string pointer and previous value of i */
             MVMGrapheme8 *old_ref = result->body.storage.blob_8;
             MVMuint64 prev_i = i;
@@ -173,6 +184,7 @@ static MVMString * re_nfg(MVMThreadContext *tc, MVMString *in) {
     out->body.storage.blob_32 = out_buffer;
     out->body.storage_type    = MVM_STRING_GRAPHEME_32;
     out->body.num_graphs      = out_pos;
+    MVM_string_narrow_storage(tc, out);
     return out;
 }
 
@@ -204,16 +216,68 @@ MVMint64 MVM_string_substrings_equal_nocheck(MVMThreadContext *tc, MVMString *a,
     }
 
     /* Normal path, for the rest of the time. */
-    MVM_string_gi_init(tc, &gia, a);
-    MVM_string_gi_init(tc, &gib, b);
-    MVM_string_gi_move_to(tc, &gia, starta);
-    MVM_string_gi_move_to(tc, &gib, startb);
+    MVM_string_gi_init_at(tc, &gia, a, starta);
+    MVM_string_gi_init_at(tc, &gib, b, startb);
     for (i = 0; i < length; i++)
         if (MVM_string_gi_get_grapheme(tc, &gia) != MVM_string_gi_get_grapheme(tc, &gib))
             return 0;
     return 1;
 }
 
+/* Fills in where each strand of a strand string starts, if that was not done
+ * yet. Should two threads race to do so, they write the same values. */
+static void ensure_strand_offsets(MVMThreadContext *tc, MVMString *s) {
+    if (!s->body.strand_offsets_ready) {
+        MVMStringStrand *strands = s->body.storage.strands;
+        MVMStringIndex   offset  = 0;
+        MVMuint16 i;
+        for (i = 0; i < s->body.num_strands; i++) {
+            strands[i].offset = offset;
+            offset += (strands[i].end - strands[i].start) * (strands[i].repetitions + 1);
+        }
+        /* Publish the offsets before the flag saying they are there. */
+        MVM_barrier();
+        s->body.strand_offsets_ready = 1;
+    }
+}
+
+/* Finds the strand of a strand string that holds the specified position,
+ * which may also be the position just past the end of the string. Returns
+ * the strand's index and sets strand_start to the position it starts at. */
+MVMuint16 MVM_string_find_strand(MVMThreadContext *tc, MVMString *s, MVMStringIndex pos,
+        MVMStringIndex *strand_start) {
+    MVMuint16 num_strands = s->body.num_strands;
+    if (num_strands >= MVM_STRING_STRAND_INDEX_MIN) {
+        /* Binary search for the last strand starting at or before pos. */
+        MVMStringStrand *strands = s->body.storage.strands;
+        MVMuint16 lo = 0, hi = num_strands - 1;
+        ensure_strand_offsets(tc, s);
+        while (lo < hi) {
+            MVMuint16 mid = (lo + hi + 1) / 2;
+            if (strands[mid].offset <= pos)
+                lo = mid;
+            else
+                hi = mid - 1;
+        }
+        *strand_start = strands[lo].offset;
+        return lo;
+    }
+    else {
+        MVMStringStrand *strands = s->body.storage.strands;
+        MVMStringIndex   offset  = 0;
+        MVMuint16 i;
+        for (i = 0; i < num_strands - 1; i++) {
+            MVMStringIndex graphs = (strands[i].end - strands[i].start)
+                * (strands[i].repetitions + 1);
+            if (pos < offset + graphs)
+                break;
+            offset += graphs;
+        }
+        *strand_start = offset;
+        return i;
+    }
+}
+
 /* Returns the codepoint without doing checks, for internal VM use only. */
 MVMGrapheme32 MVM_string_get_grapheme_at_nocheck(MVMThreadContext *tc, MVMString *a, MVMint64 index) {
     switch (a->body.storage_type) {
@@ -225,8 +289,7 @@ MVMGrapheme32 MVM_string_get_grapheme_at_nocheck(MVMThreadContext *tc, MVMString
         return a->body.storage.blob_8[index];
     case MVM_STRING_STRAND: {
         MVMGraphemeIter gi;
-        MVM_string_gi_init(tc, &gi, a);
-        MVM_string_gi_move_to(tc, &gi, index);
+        MVM_string_gi_init_at(tc, &gi, a, index);
         return MVM_string_gi_get_grapheme(tc, &gi);
     }
     default:
@@ -234,6 +297,53 @@ MVMGrapheme32 MVM_string_get_grapheme_at_nocheck(MVMThreadContext *tc, MVMString
     }
 }
 
+/* Searches for the needle in the part of the haystack from start up to end,
+ * finding either the first or last occurrence; neither may be a strand.
+ * Where the storage types differ, the needle is converted to match. */
+static MVMint64 index_flat(MVMThreadContext *tc, MVMString *Haystack, MVMString *needle,
+        MVMStringIndex start, MVMStringIndex end, MVMint32 last) {
+    MVMStringIndex n_graphs = needle->body.num_graphs;
+    MVMint64 result;
+    MVMStringIndex i;
+    if (Haystack->body.storage_type == MVM_STRING_GRAPHEME_32) {
+        MVMGrapheme32  small[32];
+        MVMGrapheme32 *n32 = needle->body.storage.blob_32;
+        if (needle->body.storage_type != MVM_STRING_GRAPHEME_32) {
+            n32 = n_graphs <= 32 ? small : MVM_malloc(n_graphs * sizeof(MVMGrapheme32));
+            for (i = 0; i < n_graphs; i++)
+                n32[i] = needle->body.storage.blob_8[i];
+        }
+        result = last
+            ? MVM_string_search_last_32(Haystack->body.storage.blob_32 + start,
+                end - start, n32, n_graphs)
+            : MVM_string_search_32(Haystack->body.storage.blob_32 + start,
+                end - start, n32, n_graphs);
+        if (n32 != small && n32 != needle->body.storage.blob_32)
+            MVM_free(n32);
+    }
+    else {
+        MVMGrapheme8  small[32];
+        MVMGrapheme8 *n8 = needle->body.storage.blob_8;
+        if (needle->body.storage_type == MVM_STRING_GRAPHEME_32) {
+            /* A grapheme that doesn't fit in 8 bits can't be in the haystack. */
+            for (i = 0; i < n_graphs; i++)
+                if (!can_fit_into_8bit(needle->body.storage.blob_32[i]))
+                    return -1;
+            n8 = n_graphs <= 32 ? small : MVM_malloc(n_graphs);
+            for (i = 0; i < n_graphs; i++)
+                n8[i] = (MVMGrapheme8)needle->body.storage.blob_32[i];
+        }
+        result = last
+            ? MVM_string_search_last_8(Haystack->body.storage.blob_8 + start,
+                end - start, n8, n_graphs)
+            : MVM_string_search_8(Haystack->body.storage.blob_8 + start,
+                end - start, n8, n_graphs);
+        if (n8 != small && n8 != needle->body.storage.blob_8)
+            MVM_free(n8);
+    }
+    return result == -1 ? -1 : result + start;
+}
+
 /* Returns the location of one string in another or -1  */
 MVMint64 MVM_string_index(MVMThreadContext *tc, MVMString *Haystack, MVMString *needle, MVMint64 start) {
     size_t index           = (size_t)start;
@@ -253,49 +363,10 @@ MVMint64 MVM_string_index(MVMThreadContext *tc, MVMString *Haystack, MVMString *
     if (n_graphs > H_graphs || n_graphs < 1)
         return -1;
 
-    /* Fast paths when storage types are identical. Uses memmem function, which
-     * uses Knuth-Morris-Pratt algorithm on Linux and on others
-     * Crochemore+Perrin two-way string matching */
-    switch (Haystack->body.storage_type) {
-        case MVM_STRING_GRAPHEME_32:
-            if (needle->body.storage_type == MVM_STRING_GRAPHEME_32) {
-                void *start_ptr = Haystack->body.storage.blob_32 + start;
-                void *mm_return_32;
-                void *end_ptr = (char*)start_ptr + sizeof(MVMGrapheme32) * (H_graphs - start);
-                do {
-                    /* Keep as void* to not lose precision */
-                    mm_return_32 = MVM_memmem(
-                        start_ptr, /* start position */
-                        (char*)end_ptr - (char*)start_ptr, /* length of Haystack from start position to end */
-                        needle->body.storage.blob_32, /* needle start */
-                        n_graphs * sizeof(MVMGrapheme32) /* needle length */
-                    );
-                    if (mm_return_32 == NULL)
-                        return -1;
-                } /* If we aren't on a 32 bit boundary then continue from where we left off (unlikely but possible) */
-                while ( ( (char*)mm_return_32 - (char*)Haystack->body.storage.blob_32) % sizeof(MVMGrapheme32)
-                    && ( start_ptr = mm_return_32 ) /* Set the new start pointer at where we left off */
-                    && ( end_ptr > start_ptr ) /* Check we aren't past the end of the string just in case */
-                );
-
-                return (MVMGrapheme32*)mm_return_32 - Haystack->body.storage.blob_32;
-            }
-            break;
-        case MVM_STRING_GRAPHEME_8:
-            if (needle->body.storage_type == MVM_STRING_GRAPHEME_8) {
-                void *mm_return_8 = MVM_memmem(
-                    Haystack->body.storage.blob_8 + start, /* start position */
-                    (H_graphs - start) * sizeof(MVMGrapheme8), /* length of Haystack from start position to end */
-                    needle->body.storage.blob_8, /* needle start */
-                    n_graphs * sizeof(MVMGrapheme8) /* needle length */
-                );
-                if (mm_return_8 == NULL)
-                    return -1;
-                else
-                    return (MVMGrapheme8*)mm_return_8 -  Haystack->body.storage.blob_8;
-            }
-            break;
-    }
+    /* Fast path when neither is a strand. */
+    if (Haystack->body.storage_type != MVM_STRING_STRAND
+            && needle->body.storage_type != MVM_STRING_STRAND)
+        return index_flat(tc, Haystack, needle, start, H_graphs, 0);
 
     /* brute force for now. horrible, yes. halp. */
     while (index <= H_graphs - n_graphs) {
@@ -344,6 +415,11 @@ MVMint64 MVM_string_index_from_end(MVMThreadContext *tc, MVMString *Haystack, MV
         index = H_graphs - n_graphs;
     }
 
+    /* Fast path when neither is a strand. */
+    if (Haystack->body.storage_type != MVM_STRING_STRAND
+            && needle->body.storage_type != MVM_STRING_STRAND)
+        return index_flat(tc, Haystack, needle, 0, index + n_graphs, 1);
+
     /* brute force for now. horrible, yes. halp. */
     do {
         if (MVM_string_substrings_equal_nocheck(tc, needle, 0, n_graphs, Haystack, index)) {
@@ -422,11 +498,35 @@ MVMString * MVM_string_substring(MVMThreadContext *tc, MVMString *a, MVMint64 of
             result->body.storage.strands[0].repetitions = 0;
         }
         else {
-            /* Produce a new blob string, collapsing the strands. */
-            MVMGraphemeIter gi;
-            MVM_string_gi_init(tc, &gi, a);
-            MVM_string_gi_move_to(tc, &gi, start_pos);
-            iterate_gi_into_string(tc, &gi, result);
+            /* Find the strands the substring starts and ends in. Unless one
+             * of those in that range is repeated, the result can be a view
+             * onto just them; otherwise, produce a new blob string,
+             * collapsing the strands. */
+            MVMStringStrand *strands = a->body.storage.strands;
+            MVMStringIndex   first_start;
+            MVMStringIndex   last_start;
+            MVMuint16 first = MVM_string_find_strand(tc, a, start_pos, &first_start);
+            MVMuint16 last  = MVM_string_find_strand(tc, a, end_pos - 1, &last_start);
+            MVMuint16 i;
+            for (i = first; i <= last; i++)
+                if (strands[i].repetitions)
+                    break;
+            if (i > last) {
+                MVMuint16 num_strands = last - first + 1;
+                result->body.storage_type    = MVM_STRING_STRAND;
+                result->body.storage.strands = allocate_strands(tc, num_strands);
+                result->body.num_strands     = num_strands;
+                memcpy(result->body.storage.strands, strands + first,
+                    num_strands * sizeof(MVMStringStrand));
+                result->body.storage.strands[num_strands - 1].end =
+                    strands[last].start + (end_pos - last_start);
+                result->body.storage.strands[0].start += start_pos - first_start;
+            }
+            else {
+                MVMGraphemeIter gi;
+                MVM_string_gi_init_at(tc, &gi, a, start_pos);
+                iterate_gi_into_string(tc, &gi, result);
+            }
         }
     });
 
@@ -738,13 +838,9 @@ void MVM_string_say(MVMThreadContext *tc, MVMString *a) {
 }
 
 void MVM_string_print(MVMThreadContext *tc, MVMString *a) {
-    MVMOSHandle *handle = (MVMOSHandle *)tc->instance->stdout_handle;
-    MVMuint64 encoded_size;
-    char *encoded;
     MVM_string_check_arg(tc, a, "print");
-    encoded = MVM_string_utf8_encode(tc, a, &encoded_size, MVM_TRANSLATE_NEWLINE_OUTPUT);
-    MVM_io_write_bytes_c(tc, tc->instance->stdout_handle, encoded, encoded_size);
-    MVM_free(encoded);
+    MVM_io_write_string_utf8(tc, tc->instance->stdout_handle, a,
+        MVM_TRANSLATE_NEWLINE_OUTPUT);
 }
 /* Meant to be pased in a MVMNormalizer of type MVM_NORMALIZE_NFD */
 static MVMGrapheme32 ord_getbasechar (MVMThreadContext *tc, MVMGrapheme32 g) {
@@ -980,6 +1076,11 @@ MVMint64 MVM_string_equal(MVMThreadContext *tc, MVMString *a, MVMString *b) {
     if (a == b)
         return 1;
 
+    /* Interned strings are unique by content, so two different ones can't
+     * be equal. */
+    if (a->body.interned && b->body.interned)
+        return 0;
+
     agraphs = MVM_string_graphs_nocheck(tc, a);
     bgraphs = MVM_string_graphs_nocheck(tc, b);
 
@@ -1039,10 +1140,91 @@ MVMint64 MVM_string_index_of_grapheme(MVMThreadContext *tc, MVMString *a, MVMGra
 
 /* Case change functions. */
 static MVMint64 grapheme_is_cclass(MVMThreadContext *tc, MVMint64 cclass, MVMGrapheme32 g);
+
+/* Case changes of each Latin-1 codepoint, for each type of case change, built
+ * from the Unicode database on first use. An entry of -1 means the result is
+ * outside of Latin-1 or more than one codepoint (for example, the upper case
+ * of U+00DF is "SS"). Building the tables always gives the same result, so it
+ * does no harm if two threads happen to do it at once. */
+static MVMint16 latin1_case_changes[4][256];
+static AO_t latin1_case_changes_built = 0;
+static void build_latin1_case_changes(MVMThreadContext *tc) {
+    MVMint32 type;
+    MVMCodepoint cp;
+    for (type = 0; type < 4; type++) {
+        for (cp = 0; cp < 256; cp++) {
+            const MVMCodepoint *result_cps;
+            MVMuint32 num_result_cps = MVM_unicode_get_case_change(tc, cp, type, &result_cps);
+            if (num_result_cps == 0)
+                latin1_case_changes[type][cp] = cp;
+            else if (num_result_cps == 1 && 0 <= *result_cps && *result_cps < 256)
+                latin1_case_changes[type][cp] = *result_cps;
+            else
+                latin1_case_changes[type][cp] = -1;
+        }
+    }
+    MVM_barrier();
+    MVM_store(&latin1_case_changes_built, 1);
+}
+
+/* Case changes a flat string in ASCII or 8-bit storage, giving a string in
+ * the same kind of storage. Runs of ASCII go through the vectorised kernel,
+ * and anything else through the Latin-1 tables. Returns NULL if there is a
+ * grapheme that needs the general path, or the original string if nothing
+ * changed. */
+static MVMString * case_change_8bit(MVMThreadContext *tc, MVMString *s, MVMint32 type) {
+    const MVMuint8 *in = s->body.storage_type == MVM_STRING_GRAPHEME_ASCII
+        ? (const MVMuint8 *)s->body.storage.blob_ascii
+        : s->body.storage.blob_8;
+    MVMStringIndex length = s->body.num_graphs;
+    MVMint32 to_upper = type == MVM_unicode_case_change_type_upper
+                     || type == MVM_unicode_case_change_type_title;
+    MVMuint8 *out;
+    const MVMint16 *table;
+    MVMString *result;
+    MVMStringIndex i = 0;
+
+    if (!MVM_load(&latin1_case_changes_built))
+        build_latin1_case_changes(tc);
+    table = latin1_case_changes[type];
+
+    out = MVM_malloc(length);
+    while (i < length) {
+        i += MVM_string_ascii_case_change(in + i, length - i, out + i, to_upper);
+        while (i < length && in[i] >= 0x80) {
+            MVMint16 changed = table[in[i]];
+            if (changed < 0) {
+                MVM_free(out);
+                return NULL;
+            }
+            out[i++] = (MVMuint8)changed;
+        }
+    }
+    if (memcmp(in, out, length) == 0) {
+        MVM_free(out);
+        return s;
+    }
+
+    result = (MVMString *)MVM_repr_alloc_init(tc, tc->instance->VMString);
+    result->body.num_graphs   = length;
+    result->body.storage_type = s->body.storage_type;
+    if (s->body.storage_type == MVM_STRING_GRAPHEME_ASCII)
+        result->body.storage.blob_ascii = (MVMGraphemeASCII *)out;
+    else
+        result->body.storage.blob_8 = out;
+    return result;
+}
+
 static MVMString * do_case_change(MVMThreadContext *tc, MVMString *s, MVMint32 type, char *error) {
     MVMint64 sgraphs;
     MVM_string_check_arg(tc, s, error);
     sgraphs = MVM_string_graphs_nocheck(tc, s);
+    if (sgraphs && (s->body.storage_type == MVM_STRING_GRAPHEME_8
+            || s->body.storage_type == MVM_STRING_GRAPHEME_ASCII)) {
+        MVMString *result = case_change_8bit(tc, s, type);
+        if (result)
+            return result;
+    }
     if (sgraphs) {
         MVMString *result;
         MVMGraphemeIter gi;
@@ -1312,54 +1494,115 @@ MVMString * MVM_string_decode_from_buf(MVMThreadContext *tc, MVMObject *buf, MVM
         encoding_flag);
 }
 
-MVMObject * MVM_string_split(MVMThreadContext *tc, MVMString *separator, MVMString *input) {
-    MVMObject *result;
-    MVMStringIndex start, end, sep_length;
-    MVMHLLConfig *hll = MVM_hll_current(tc);
-
-    MVM_string_check_arg(tc, separator, "split separator");
-    MVM_string_check_arg(tc, input, "split input");
+/* Finds the next occurrence of a flat separator in a flat input at or after
+ * start, returning -1 if there is none. Single-grapheme separators, the most
+ * common case by far, get a dedicated scan. */
+static MVMint64 find_separator(MVMThreadContext *tc, MVMString *input, MVMString *separator,
+        MVMStringIndex start, MVMStringIndex end) {
+    MVMint64 found;
+    if (separator->body.num_graphs != 1)
+        return index_flat(tc, input, separator, start, end, 0);
+    if (input->body.storage_type == MVM_STRING_GRAPHEME_32) {
+        found = MVM_string_find_grapheme_32(input->body.storage.blob_32 + start,
+            end - start, MVM_string_get_grapheme_at_nocheck(tc, separator, 0));
+    }
+    else {
+        MVMGrapheme32 g = MVM_string_get_grapheme_at_nocheck(tc, separator, 0);
+        if (!can_fit_into_8bit(g))
+            return -1;
+        found = MVM_string_find_grapheme_8(input->body.storage.blob_8 + start,
+            end - start, (MVMGrapheme8)g);
+    }
+    return found == -1 ? -1 : found + start;
+}
 
+/* Splits the input on the separator, pushing the fields onto the result
+ * array; boxed in the HLL's string type unless native is set, in which case
+ * the result must be a native str array. Strand inputs are flattened once up
+ * front, so that the separator can be searched for in the flat storage and
+ * every field is a single-strand view into that rather than a copy. */
+static void split_into(MVMThreadContext *tc, MVMString *separator, MVMString *input,
+        MVMObject *result, MVMint32 native) {
+    MVMHLLConfig *hll = MVM_hll_current(tc);
+    MVMStringIndex start, end, sep_length;
     MVMROOT(tc, input, {
     MVMROOT(tc, separator, {
-        result = MVM_repr_alloc_init(tc, hll->slurpy_array_type);
-        MVMROOT(tc, result, {
-            start = 0;
-            end = MVM_string_graphs_nocheck(tc, input);
-            sep_length = MVM_string_graphs_nocheck(tc, separator);
-
-            while (start < end) {
-                MVMString *portion;
-                MVMStringIndex index;
-                MVMStringIndex length;
-
-                /* XXX make this use the dual-traverse iterator, but such that it
-                    can reset the index of what it's comparing... <!> */
-                index = MVM_string_index(tc, input, separator, start);
-                length = sep_length ? (index == -1 ? end : index) - start : 1;
-                if (length > 0 || (sep_length && length == 0)) {
-                    portion = MVM_string_substring(tc, input, start, length);
+    MVMROOT(tc, result, {
+        if (input->body.storage_type == MVM_STRING_STRAND)
+            input = collapse_strands(tc, input);
+        if (separator->body.storage_type == MVM_STRING_STRAND)
+            separator = collapse_strands(tc, separator);
+        start = 0;
+        end = MVM_string_graphs_nocheck(tc, input);
+        sep_length = MVM_string_graphs_nocheck(tc, separator);
+
+        while (start < end) {
+            MVMString *portion;
+            MVMint64 index;
+            MVMStringIndex length;
+
+            index = sep_length ? find_separator(tc, input, separator, start, end) : start;
+            length = sep_length ? (index == -1 ? end : index) - start : 1;
+            if (length > 0 || (sep_length && length == 0)) {
+                portion = MVM_string_substring(tc, input, start, length);
+                if (native) {
+                    MVM_repr_push_s(tc, result, portion);
+                }
+                else {
                     MVMROOT(tc, portion, {
                         MVMObject *pobj = MVM_repr_alloc_init(tc, hll->str_box_type);
                         MVM_repr_set_str(tc, pobj, portion);
                         MVM_repr_push_o(tc, result, pobj);
                     });
                 }
-                start += length + sep_length;
-                /* Gather an empty string if the delimiter is found at the end. */
-                if (sep_length && start == end) {
+            }
+            start += length + sep_length;
+            /* Gather an empty string if the delimiter is found at the end. */
+            if (sep_length && start == end) {
+                if (native) {
+                    MVM_repr_push_s(tc, result, tc->instance->str_consts.empty);
+                }
+                else {
                     MVMObject *pobj = MVM_repr_alloc_init(tc, hll->str_box_type);
                     MVM_repr_set_str(tc, pobj, tc->instance->str_consts.empty);
                     MVM_repr_push_o(tc, result, pobj);
                 }
             }
-        });
+        }
     });
     });
+    });
+}
+
+MVMObject * MVM_string_split(MVMThreadContext *tc, MVMString *separator, MVMString *input) {
+    MVMObject *result;
+
+    MVM_string_check_arg(tc, separator, "split separator");
+    MVM_string_check_arg(tc, input, "split input");
+
+    MVMROOT(tc, input, {
+    MVMROOT(tc, separator, {
+        result = MVM_repr_alloc_init(tc, MVM_hll_current(tc)->slurpy_array_type);
+    });
+    });
+    split_into(tc, separator, input, result, 0);
 
     return result;
 }
 
+/* Splits the input on the separator into a native str array, which is
+ * emptied first; this avoids allocating a boxed object per field. */
+void MVM_string_split_native(MVMThreadContext *tc, MVMString *separator, MVMString *input,
+        MVMObject *target) {
+    MVM_string_check_arg(tc, separator, "splitnative separator");
+    MVM_string_check_arg(tc, input, "splitnative input");
+    if (!IS_CONCRETE(target) || REPR(target)->pos_funcs.get_elem_storage_spec(tc,
+            STABLE(target)).boxed_primitive != MVM_STORAGE_SPEC_BP_STR)
+        MVM_exception_throw_adhoc(tc, "splitnative needs a concrete native str array");
+    MVM_repr_pos_set_elems(tc, target, 0);
+    split_into(tc, separator, input, target, 1);
+}
+
 MVMString * MVM_string_join(MVMThreadContext *tc, MVMString *separator, MVMObject *input) {
     MVMString  *result;
     MVMString **pieces;
@@ -1909,11 +2152,31 @@ static MVMint64 UPV_Pi = 0;
 static MVMint64 UPV_Pf = 0;
 static MVMint64 UPV_Po = 0;
 
+/* Which Latin-1 codepoints are in each character class, indexed by which bit
+ * the class constant has set. */
+#define NUM_LATIN1_CCLASSES 14
+static MVMByteSet latin1_cclasses[NUM_LATIN1_CCLASSES];
+
+/* Gets the set of Latin-1 codepoints in a character class, or NULL if it is
+ * not a class we hold one for. */
+static const MVMByteSet * latin1_cclass(MVMint64 cclass) {
+    MVMuint32 i = 0;
+    if (cclass <= 0 || cclass >= (1 << NUM_LATIN1_CCLASSES) || (cclass & (cclass - 1)))
+        return NULL;
+    while (!(cclass & (1 << i)))
+        i++;
+    return &latin1_cclasses[i];
+}
+
 /* concatenating with "" ensures that only literal strings are accepted as argument. */
 #define STR_WITH_LEN(str)  ("" str ""), (sizeof(str) - 1)
 
-/* Resolves various unicode property values that we'll need. */
+/* Resolves various unicode property values that we'll need, and works out the
+ * character classes of the Latin-1 range. */
+static MVMint64 codepoint_is_cclass(MVMThreadContext *tc, MVMint64 cclass, MVMCodepoint cp);
 void MVM_string_cclass_init(MVMThreadContext *tc) {
+    MVMuint32 i;
+    MVMCodepoint cp;
     UPV_Nd = MVM_unicode_cname_to_property_value_code(tc,
         MVM_UNICODE_PROPERTY_GENERAL_CATEGORY, STR_WITH_LEN("Nd"));
     UPV_Lu = MVM_unicode_cname_to_property_value_code(tc,
@@ -1944,17 +2207,32 @@ void MVM_string_cclass_init(MVMThreadContext *tc) {
         MVM_UNICODE_PROPERTY_GENERAL_CATEGORY, STR_WITH_LEN("Pf"));
     UPV_Po = MVM_unicode_cname_to_property_value_code(tc,
         MVM_UNICODE_PROPERTY_GENERAL_CATEGORY, STR_WITH_LEN("Po"));
+
+    for (i = 0; i < NUM_LATIN1_CCLASSES; i++) {
+        MVMByteSet *set = &latin1_cclasses[i];
+        memset(set->bits, 0, sizeof(set->bits));
+        for (cp = 0; cp < 256; cp++)
+            if (codepoint_is_cclass(tc, 1 << i, cp))
+                set->bits[cp >> 3] |= 1 << (cp & 7);
+        MVM_string_byte_set_init(set);
+    }
 }
 
-/* Checks if the specified grapheme is in the given character class. */
+/* Checks if the specified grapheme is in the given character class, using
+ * the Latin-1 tables where we can. */
 static MVMint64 grapheme_is_cclass(MVMThreadContext *tc, MVMint64 cclass, MVMGrapheme32 g) {
-    /* If it's a synthetic, then grab the base codepoint. */
-    MVMCodepoint cp;
-    if (g >= 0)
-        cp = (MVMCodepoint)g;
-    else
-        cp = MVM_nfg_get_synthetic_info(tc, g)->base;
+    const MVMByteSet *set;
+    if (0 <= g && g < 256 && (set = latin1_cclass(cclass)))
+        return (set->bits[g >> 3] >> (g & 7)) & 1;
 
+    /* If it's a synthetic, then use the base codepoint. */
+    return codepoint_is_cclass(tc, cclass,
+        g >= 0 ? (MVMCodepoint)g : MVM_nfg_get_synthetic_info(tc, g)->base);
+}
+
+/* Checks if the specified codepoint is in the given character class, by
+ * looking at its Unicode properties. */
+static MVMint64 codepoint_is_cclass(MVMThreadContext *tc, MVMint64 cclass, MVMCodepoint cp) {
     switch (cclass) {
         case MVM_CCLASS_ANY:
             return 1;
@@ -2082,6 +2360,7 @@ MVMint64 MVM_string_is_cclass(MVMThreadContext *tc, MVMint64 cclass, MVMString *
 MVMint64 MVM_string_find_cclass(MVMThreadContext *tc, MVMint64 cclass, MVMString *s, MVMint64 offset, MVMint64 count) {
     MVMGraphemeIter gi;
     MVMint64        length, end, pos;
+    const MVMByteSet *set;
 
     MVM_string_check_arg(tc, s, "find_cclass");
 
@@ -2091,8 +2370,14 @@ MVMint64 MVM_string_find_cclass(MVMThreadContext *tc, MVMint64 cclass, MVMString
     if (offset < 0 || offset >= length)
         return end;
 
-    MVM_string_gi_init(tc, &gi, s);
-    MVM_string_gi_move_to(tc, &gi, offset);
+    /* Strings in 8-bit storage can be scanned a vector at a time. */
+    set = latin1_cclass(cclass);
+    if (set && end > offset && (s->body.storage_type == MVM_STRING_GRAPHEME_8
+            || s->body.storage_type == MVM_STRING_GRAPHEME_ASCII))
+        return offset + MVM_string_scan_byte_set(s->body.storage.blob_8 + offset,
+            end - offset, set, 0);
+
+    MVM_string_gi_init_at(tc, &gi, s, offset);
     for (pos = offset; pos < end; pos++) {
         MVMGrapheme32 g = MVM_string_gi_get_grapheme(tc, &gi);
         if (grapheme_is_cclass(tc, cclass, g) > 0)
@@ -2106,6 +2391,7 @@ MVMint64 MVM_string_find_cclass(MVMThreadContext *tc, MVMint64 cclass, MVMString
 MVMint64 MVM_string_find_not_cclass(MVMThreadContext *tc, MVMint64 cclass, MVMString *s, MVMint64 offset, MVMint64 count) {
     MVMGraphemeIter gi;
     MVMint64        length, end, pos;
+    const MVMByteSet *set;
 
     MVM_string_check_arg(tc, s, "find_not_cclass");
 
@@ -2115,8 +2401,13 @@ MVMint64 MVM_string_find_not_cclass(MVMThreadContext *tc, MVMint64 cclass, MVMSt
     if (offset < 0 || offset >= length)
         return end;
 
-    MVM_string_gi_init(tc, &gi, s);
-    MVM_string_gi_move_to(tc, &gi, offset);
+    set = latin1_cclass(cclass);
+    if (set && end > offset && (s->body.storage_type == MVM_STRING_GRAPHEME_8
+            || s->body.storage_type == MVM_STRING_GRAPHEME_ASCII))
+        return offset + MVM_string_scan_byte_set(s->body.storage.blob_8 + offset,
+            end - offset, set, 1);
+
+    MVM_string_gi_init_at(tc, &gi, s, offset);
     for (pos = offset; pos < end; pos++) {
         MVMGrapheme32 g = MVM_string_gi_get_grapheme(tc, &gi);
         if (grapheme_is_cclass(tc, cclass, g) == 0)
@@ -277,10 +277,115 @@ static double parse_real(MVMThreadContext *tc, MVMCodepointIter *ci, MVMCodepoin
     return result;
 }
 
+static int is_ascii_whitespace(MVMuint8 c) {
+    return c == ' ' || (c <= 13 && c >= 9);
+}
+
+/* Parses strings in ASCII or 8-bit storage that hold a plain decimal number,
+ * perhaps with a sign, fractional part and exponent, and surrounded by ASCII
+ * whitespace. Up to 19 significant digits are gathered into an integer and
+ * turned into the correctly rounded double. Returns 0, having done nothing,
+ * for anything else (underscores, radix forms, Inf and NaN, non-ASCII chars,
+ * or values that can't be quickly decided), which is left to the general
+ * parser. */
+static int parse_plain_decimal(MVMThreadContext *tc, MVMString *s, MVMnum64 *result) {
+    const MVMuint8 *p, *end;
+    MVMuint64 mantissa    = 0;
+    MVMint64  exp10       = 0;
+    MVMint32  sig_digits  = 0;
+    MVMint32  truncated   = 0;
+    MVMint32  negative    = 0;
+    MVMint32  seen_digits = 0;
+
+    if (s->body.storage_type == MVM_STRING_GRAPHEME_ASCII)
+        p = (const MVMuint8 *)s->body.storage.blob_ascii;
+    else if (s->body.storage_type == MVM_STRING_GRAPHEME_8)
+        p = (const MVMuint8 *)s->body.storage.blob_8;
+    else
+        return 0;
+    end = p + s->body.num_graphs;
+
+    while (p < end && is_ascii_whitespace(*p))
+        p++;
+    if (p < end && (*p == '-' || *p == '+'))
+        negative = *p++ == '-';
+
+    /* Integer part. Leading zeros are skipped, and digits past the 19th are
+     * dropped, scaling the exponent instead. */
+    while (p < end && *p >= '0' && *p <= '9') {
+        MVMuint8 digit = *p++ - '0';
+        seen_digits = 1;
+        if (sig_digits < 19) {
+            if (mantissa || digit) {
+                mantissa = mantissa * 10 + digit;
+                sig_digits++;
+            }
+        }
+        else {
+            exp10++;
+            if (digit)
+                truncated = 1;
+        }
+    }
+
+    /* Fractional part, which must have digits if there's a point. */
+    if (p < end && *p == '.') {
+        const MVMuint8 *frac_start = ++p;
+        while (p < end && *p >= '0' && *p <= '9') {
+            MVMuint8 digit = *p++ - '0';
+            if (sig_digits < 19) {
+                if (mantissa || digit) {
+                    mantissa = mantissa * 10 + digit;
+                    sig_digits++;
+                }
+                exp10--;
+            }
+            else if (digit) {
+                truncated = 1;
+            }
+        }
+        if (p == frac_start)
+            return 0;
+        seen_digits = 1;
+    }
+    if (!seen_digits)
+        return 0;
+
+    /* Exponent, which must have digits if there's an e. */
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        MVMint32 exp_negative = 0;
+        MVMint64 exponent = 0;
+        const MVMuint8 *exp_start;
+        p++;
+        if (p < end && (*p == '-' || *p == '+'))
+            exp_negative = *p++ == '-';
+        exp_start = p;
+        while (p < end && *p >= '0' && *p <= '9') {
+            if (exponent < 100000)
+                exponent = exponent * 10 + (*p - '0');
+            p++;
+        }
+        if (p == exp_start)
+            return 0;
+        exp10 += exp_negative ? -exponent : exponent;
+    }
+
+    while (p < end && is_ascii_whitespace(*p))
+        p++;
+    if (p != end)
+        return 0;
+
+    return MVM_num_from_decimal(tc, mantissa, exp10, negative, truncated, result);
+}
+
 MVMnum64 MVM_coerce_s_n(MVMThreadContext *tc, MVMString *s) {
     MVMCodepointIter ci;
     MVMCodepoint cp;
     MVMnum64  n = 123;
+
+    if (s && parse_plain_decimal(tc, s, &n))
+        return n;
+
     MVM_string_ci_init(tc, &ci, s, 0);
 
     if (get_cp(tc, &ci, &cp)) return 0; 
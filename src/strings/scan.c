@@ -0,0 +1,375 @@
+#include "moar.h"
+#include "platform/sys.h"
+#include "strings/simd.h"
+
+/* Portable versions, looking at 8 bytes at a time. A byte is \r exactly when
+ * XOR-ing it with \r gives zero, which the usual has-zero-byte trick spots. */
+#define ONES  0x0101010101010101ULL
+#define HIGHS 0x8080808080808080ULL
+static size_t scan_ascii_scalar(const MVMuint8 *bytes, size_t length) {
+    size_t i = 0;
+    while (i + 8 <= length) {
+        MVMuint64 word, cr;
+        memcpy(&word, bytes + i, 8);
+        cr = word ^ (ONES * 0x0D);
+        if (((word | ((cr - ONES) & ~cr)) & HIGHS) != 0)
+            break;
+        i += 8;
+    }
+    while (i < length && bytes[i] < 0x80 && bytes[i] != 0x0D)
+        i++;
+    return i;
+}
+
+#if MVM_SCAN_SSE2
+/* A compare against \r gives 0xFF for a match, so OR-ing it in means we can
+ * find the first non-ASCII byte or \r from the sign bits alone. */
+static size_t scan_ascii_sse2(const MVMuint8 *bytes, size_t length) {
+    const __m128i cr = _mm_set1_epi8(0x0D);
+    size_t i = 0;
+    while (i + 16 <= length) {
+        __m128i chunk = _mm_loadu_si128((const __m128i *)(bytes + i));
+        MVMuint32 mask = (MVMuint32)_mm_movemask_epi8(
+            _mm_or_si128(chunk, _mm_cmpeq_epi8(chunk, cr)));
+        if (mask)
+            return i + lowest_set_bit(mask);
+        i += 16;
+    }
+    return i + scan_ascii_scalar(bytes + i, length - i);
+}
+#endif
+
+#if MVM_SCAN_AVX2
+MVM_TARGET_AVX2
+static size_t scan_ascii_avx2(const MVMuint8 *bytes, size_t length) {
+    const __m256i cr = _mm256_set1_epi8(0x0D);
+    size_t i = 0;
+    while (i + 32 <= length) {
+        __m256i chunk = _mm256_loadu_si256((const __m256i *)(bytes + i));
+        MVMuint32 mask = (MVMuint32)_mm256_movemask_epi8(
+            _mm256_or_si256(chunk, _mm256_cmpeq_epi8(chunk, cr)));
+        if (mask)
+            return i + lowest_set_bit(mask);
+        i += 32;
+    }
+    return i + scan_ascii_scalar(bytes + i, length - i);
+}
+#endif
+
+/* Portable versions of the encoding kernels. Any byte with its top bit set
+ * ends a 7-bit run; when narrowing, a grapheme ends the run if any bit above
+ * the bottom 7 is set, which also catches negative (synthetic) graphemes. */
+static size_t scan_7bit_scalar(const MVMuint8 *bytes, size_t length) {
+    size_t i = 0;
+    while (i + 8 <= length) {
+        MVMuint64 word;
+        memcpy(&word, bytes + i, 8);
+        if (word & HIGHS)
+            break;
+        i += 8;
+    }
+    while (i < length && bytes[i] < 0x80)
+        i++;
+    return i;
+}
+static size_t narrow_ascii_scalar(const MVMGrapheme32 *in, size_t length, MVMuint8 *out) {
+    size_t i = 0;
+    while (i < length && ((MVMuint32)in[i] & ~0x7FU) == 0) {
+        out[i] = (MVMuint8)in[i];
+        i++;
+    }
+    return i;
+}
+
+#if MVM_SCAN_SSE2
+static size_t scan_7bit_sse2(const MVMuint8 *bytes, size_t length) {
+    size_t i = 0;
+    while (i + 16 <= length) {
+        MVMuint32 mask = (MVMuint32)_mm_movemask_epi8(
+            _mm_loadu_si128((const __m128i *)(bytes + i)));
+        if (mask)
+            return i + lowest_set_bit(mask);
+        i += 16;
+    }
+    return i + scan_7bit_scalar(bytes + i, length - i);
+}
+
+/* Checks 16 graphemes at a time are in range, then packs them down to bytes.
+ * Both packs saturate, but everything is known to be below 0x80 by then. */
+static size_t narrow_ascii_sse2(const MVMGrapheme32 *in, size_t length, MVMuint8 *out) {
+    const __m128i high = _mm_set1_epi32(~0x7F);
+    size_t i = 0;
+    while (i + 16 <= length) {
+        __m128i a = _mm_loadu_si128((const __m128i *)(in + i));
+        __m128i b = _mm_loadu_si128((const __m128i *)(in + i + 4));
+        __m128i c = _mm_loadu_si128((const __m128i *)(in + i + 8));
+        __m128i d = _mm_loadu_si128((const __m128i *)(in + i + 12));
+        __m128i any = _mm_and_si128(_mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d)), high);
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(any, _mm_setzero_si128())) != 0xFFFF)
+            break;
+        _mm_storeu_si128((__m128i *)(out + i), _mm_packus_epi16(
+            _mm_packs_epi32(a, b), _mm_packs_epi32(c, d)));
+        i += 16;
+    }
+    return i + narrow_ascii_scalar(in + i, length - i, out + i);
+}
+#endif
+
+#if MVM_SCAN_AVX2
+MVM_TARGET_AVX2
+static size_t scan_7bit_avx2(const MVMuint8 *bytes, size_t length) {
+    size_t i = 0;
+    while (i + 32 <= length) {
+        MVMuint32 mask = (MVMuint32)_mm256_movemask_epi8(
+            _mm256_loadu_si256((const __m256i *)(bytes + i)));
+        if (mask)
+            return i + lowest_set_bit(mask);
+        i += 32;
+    }
+    return i + scan_7bit_scalar(bytes + i, length - i);
+}
+
+/* As for SSE2, but 32 graphemes at a time. The AVX2 packs work within each
+ * 128-bit lane, so a final permute puts the 4-byte groups back in order. */
+MVM_TARGET_AVX2
+static size_t narrow_ascii_avx2(const MVMGrapheme32 *in, size_t length, MVMuint8 *out) {
+    const __m256i high  = _mm256_set1_epi32(~0x7F);
+    const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+    size_t i = 0;
+    while (i + 32 <= length) {
+        __m256i a = _mm256_loadu_si256((const __m256i *)(in + i));
+        __m256i b = _mm256_loadu_si256((const __m256i *)(in + i + 8));
+        __m256i c = _mm256_loadu_si256((const __m256i *)(in + i + 16));
+        __m256i d = _mm256_loadu_si256((const __m256i *)(in + i + 24));
+        __m256i any = _mm256_and_si256(_mm256_or_si256(_mm256_or_si256(a, b),
+            _mm256_or_si256(c, d)), high);
+        if (!_mm256_testz_si256(any, any))
+            break;
+        _mm256_storeu_si256((__m256i *)(out + i), _mm256_permutevar8x32_epi32(
+            _mm256_packus_epi16(_mm256_packs_epi32(a, b), _mm256_packs_epi32(c, d)),
+            order));
+        i += 32;
+    }
+    return i + narrow_ascii_scalar(in + i, length - i, out + i);
+}
+#endif
+
+/* Portable version of the ASCII case change kernel. Letters in the range
+ * being changed from differ from their other case only in bit 5. */
+static size_t ascii_case_change_scalar(const MVMuint8 *in, size_t length, MVMuint8 *out,
+        MVMint32 to_upper) {
+    MVMuint8 first = to_upper ? 'a' : 'A';
+    size_t i = 0;
+    while (i < length && in[i] < 0x80) {
+        out[i] = (MVMuint8)(in[i] - first) < 26 ? in[i] ^ 0x20 : in[i];
+        i++;
+    }
+    return i;
+}
+
+#if MVM_SCAN_SSE2
+/* Any byte with its top bit set ends the run; otherwise everything is in the
+ * range 0 to 0x7F, so the signed compares find the letters to flip. */
+static size_t ascii_case_change_sse2(const MVMuint8 *in, size_t length, MVMuint8 *out,
+        MVMint32 to_upper) {
+    const __m128i before = _mm_set1_epi8(to_upper ? 'a' - 1 : 'A' - 1);
+    const __m128i after  = _mm_set1_epi8(to_upper ? 'z' + 1 : 'Z' + 1);
+    const __m128i flip   = _mm_set1_epi8(0x20);
+    size_t i = 0;
+    while (i + 16 <= length) {
+        __m128i chunk = _mm_loadu_si128((const __m128i *)(in + i));
+        __m128i letters;
+        if (_mm_movemask_epi8(chunk))
+            break;
+        letters = _mm_and_si128(_mm_cmpgt_epi8(chunk, before), _mm_cmplt_epi8(chunk, after));
+        _mm_storeu_si128((__m128i *)(out + i),
+            _mm_xor_si128(chunk, _mm_and_si128(letters, flip)));
+        i += 16;
+    }
+    return i + ascii_case_change_scalar(in + i, length - i, out + i, to_upper);
+}
+#endif
+
+#if MVM_SCAN_AVX2
+MVM_TARGET_AVX2
+static size_t ascii_case_change_avx2(const MVMuint8 *in, size_t length, MVMuint8 *out,
+        MVMint32 to_upper) {
+    const __m256i before = _mm256_set1_epi8(to_upper ? 'a' - 1 : 'A' - 1);
+    const __m256i after  = _mm256_set1_epi8(to_upper ? 'z' + 1 : 'Z' + 1);
+    const __m256i flip   = _mm256_set1_epi8(0x20);
+    size_t i = 0;
+    while (i + 32 <= length) {
+        __m256i chunk = _mm256_loadu_si256((const __m256i *)(in + i));
+        __m256i letters;
+        if (_mm256_movemask_epi8(chunk))
+            break;
+        letters = _mm256_and_si256(_mm256_cmpgt_epi8(chunk, before),
+            _mm256_cmpgt_epi8(after, chunk));
+        _mm256_storeu_si256((__m256i *)(out + i),
+            _mm256_xor_si256(chunk, _mm256_and_si256(letters, flip)));
+        i += 32;
+    }
+    return i + ascii_case_change_scalar(in + i, length - i, out + i, to_upper);
+}
+#endif
+
+/* Byte set scanning. The portable version is a bitmap lookup per byte. */
+static size_t scan_byte_set_scalar(const MVMuint8 *bytes, size_t length,
+        const MVMByteSet *set, MVMint32 in_set) {
+    size_t i = 0;
+    while (i < length && !(set->bits[bytes[i] >> 3] & (1 << (bytes[i] & 7))) == !in_set)
+        i++;
+    return i;
+}
+
+#if MVM_SCAN_AVX2
+/* Looks up 32 bytes at a time with two shuffles: the low nibble of each byte
+ * picks a row of the set from one of the nibble tables, which the high nibble
+ * then picks a bit from. */
+MVM_TARGET_AVX2
+static size_t scan_byte_set_avx2(const MVMuint8 *bytes, size_t length,
+        const MVMByteSet *set, MVMint32 in_set) {
+    const __m256i rows_low  = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128((const __m128i *)set->rows_low));
+    const __m256i rows_high = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128((const __m128i *)set->rows_high));
+    const __m256i bit_of    = _mm256_setr_epi8(
+        1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128,
+        1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+    const __m256i nibble    = _mm256_set1_epi8(0x0F);
+    const __m256i seven     = _mm256_set1_epi8(7);
+    MVMuint32 flip = in_set ? 0xFFFFFFFF : 0;
+    size_t i = 0;
+    while (i + 32 <= length) {
+        __m256i chunk = _mm256_loadu_si256((const __m256i *)(bytes + i));
+        __m256i low   = _mm256_and_si256(chunk, nibble);
+        __m256i high  = _mm256_and_si256(_mm256_srli_epi16(chunk, 4), nibble);
+        __m256i row   = _mm256_blendv_epi8(
+            _mm256_shuffle_epi8(rows_low, low),
+            _mm256_shuffle_epi8(rows_high, low),
+            _mm256_cmpgt_epi8(high, seven));
+        __m256i bit   = _mm256_shuffle_epi8(bit_of, high);
+        MVMuint32 mask = flip ^ (MVMuint32)_mm256_movemask_epi8(
+            _mm256_cmpeq_epi8(_mm256_and_si256(row, bit), bit));
+        if (mask)
+            return i + lowest_set_bit(mask);
+        i += 32;
+    }
+    return i + scan_byte_set_scalar(bytes + i, length - i, set, in_set);
+}
+#endif
+
+/* Picks the best version the CPU we're on can run. */
+typedef size_t (*scan_func)(const MVMuint8 *bytes, size_t length);
+typedef size_t (*narrow_func)(const MVMGrapheme32 *in, size_t length, MVMuint8 *out);
+typedef size_t (*byte_set_func)(const MVMuint8 *bytes, size_t length,
+    const MVMByteSet *set, MVMint32 in_set);
+typedef size_t (*case_change_func)(const MVMuint8 *in, size_t length, MVMuint8 *out,
+    MVMint32 to_upper);
+static scan_func pick_scan_ascii(void) {
+#if MVM_SCAN_AVX2
+    if (MVM_platform_cpu_features() & MVM_CPU_FEATURE_AVX2)
+        return scan_ascii_avx2;
+#endif
+#if MVM_SCAN_SSE2
+    if (MVM_platform_cpu_features() & MVM_CPU_FEATURE_SSE2)
+        return scan_ascii_sse2;
+#endif
+    return scan_ascii_scalar;
+}
+
+size_t MVM_string_scan_ascii(const MVMuint8 *bytes, size_t length) {
+    static scan_func impl = NULL;
+    if (!impl)
+        impl = pick_scan_ascii();
+    return impl(bytes, length);
+}
+
+static scan_func pick_scan_7bit(void) {
+#if MVM_SCAN_AVX2
+    if (MVM_platform_cpu_features() & MVM_CPU_FEATURE_AVX2)
+        return scan_7bit_avx2;
+#endif
+#if MVM_SCAN_SSE2
+    if (MVM_platform_cpu_features() & MVM_CPU_FEATURE_SSE2)
+        return scan_7bit_sse2;
+#endif
+    return scan_7bit_scalar;
+}
+
+size_t MVM_string_scan_7bit(const MVMuint8 *bytes, size_t length) {
+    static scan_func impl = NULL;
+    if (!impl)
+        impl = pick_scan_7bit();
+    return impl(bytes, length);
+}
+
+static narrow_func pick_narrow_ascii(void) {
+#if MVM_SCAN_AVX2
+    if (MVM_platform_cpu_features() & MVM_CPU_FEATURE_AVX2)
+        return narrow_ascii_avx2;
+#endif
+#if MVM_SCAN_SSE2
+    if (MVM_platform_cpu_features() & MVM_CPU_FEATURE_SSE2)
+        return narrow_ascii_sse2;
+#endif
+    return narrow_ascii_scalar;
+}
+
+size_t MVM_string_narrow_ascii(const MVMGrapheme32 *in, size_t length, MVMuint8 *out) {
+    static narrow_func impl = NULL;
+    if (!impl)
+        impl = pick_narrow_ascii();
+    return impl(in, length, out);
+}
+
+static case_change_func pick_ascii_case_change(void) {
+#if MVM_SCAN_AVX2
+    if (MVM_platform_cpu_features() & MVM_CPU_FEATURE_AVX2)
+        return ascii_case_change_avx2;
+#endif
+#if MVM_SCAN_SSE2
+    if (MVM_platform_cpu_features() & MVM_CPU_FEATURE_SSE2)
+        return ascii_case_change_sse2;
+#endif
+    return ascii_case_change_scalar;
+}
+
+size_t MVM_string_ascii_case_change(const MVMuint8 *in, size_t length, MVMuint8 *out,
+        MVMint32 to_upper) {
+    static case_change_func impl = NULL;
+    if (!impl)
+        impl = pick_ascii_case_change();
+    return impl(in, length, out, to_upper);
+}
+
+/* Fills in the nibble tables of a byte set from its bitmap. */
+void MVM_string_byte_set_init(MVMByteSet *set) {
+    MVMuint32 b;
+    memset(set->rows_low, 0, sizeof(set->rows_low));
+    memset(set->rows_high, 0, sizeof(set->rows_high));
+    for (b = 0; b < 256; b++) {
+        if (set->bits[b >> 3] & (1 << (b & 7))) {
+            if (b < 128)
+                set->rows_low[b & 15] |= 1 << (b >> 4);
+            else
+                set->rows_high[b & 15] |= 1 << ((b >> 4) & 7);
+        }
+    }
+}
+
+static byte_set_func pick_scan_byte_set(void) {
+#if MVM_SCAN_AVX2
+    if (MVM_platform_cpu_features() & MVM_CPU_FEATURE_AVX2)
+        return scan_byte_set_avx2;
+#endif
+    return scan_byte_set_scalar;
+}
+
+size_t MVM_string_scan_byte_set(const MVMuint8 *bytes, size_t length, const MVMByteSet *set,
+        MVMint32 in_set) {
+    static byte_set_func impl = NULL;
+    if (!impl)
+        impl = pick_scan_byte_set();
+    return impl(bytes, length, set, in_set);
+}
@@ -0,0 +1,35 @@
+/* Byte scanning routines used by the encodings and string ops. Each has a
+ * portable version along with SSE2 and AVX2 versions, picked between at
+ * runtime. */
+
+/* Returns how many bytes at the start of the buffer are ASCII other than \r;
+ * that is, bytes that always decode to a grapheme by themselves. */
+size_t MVM_string_scan_ascii(const MVMuint8 *bytes, size_t length);
+
+/* Returns how many bytes at the start of the buffer have the top bit clear. */
+size_t MVM_string_scan_7bit(const MVMuint8 *bytes, size_t length);
+
+/* Copies graphemes from the start of the input to the output as bytes for as
+ * long as they are in the range 0 to 0x7F, returning how many were copied. */
+size_t MVM_string_narrow_ascii(const MVMGrapheme32 *in, size_t length, MVMuint8 *out);
+
+/* Upper cases (or, if to_upper is zero, lower cases) bytes from the start of
+ * the input into the output for as long as they have the top bit clear,
+ * returning how many were done. The input and output may be the same. */
+size_t MVM_string_ascii_case_change(const MVMuint8 *in, size_t length, MVMuint8 *out,
+    MVMint32 to_upper);
+
+/* A set of byte values. The bitmap has bit (b & 7) of bits[b >> 3] set for
+ * each byte b in the set; the row tables hold the same bits rearranged for
+ * vectorised lookups by MVM_string_byte_set_init. */
+struct MVMByteSet {
+    MVMuint8 bits[32];
+    MVMuint8 rows_low[16];
+    MVMuint8 rows_high[16];
+};
+void MVM_string_byte_set_init(MVMByteSet *set);
+
+/* Returns how many bytes at the start of the buffer are in the set or, if
+ * in_set is zero, how many are not. */
+size_t MVM_string_scan_byte_set(const MVMuint8 *bytes, size_t length, const MVMByteSet *set,
+    MVMint32 in_set);
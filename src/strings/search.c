@@ -0,0 +1,449 @@
+#include "moar.h"
+#include "platform/sys.h"
+#include "strings/simd.h"
+
+/* Searching for a needle in a haystack, where both are flat arrays of
+ * graphemes of the same width. Long needles use Boyer-Moore-Horspool, which
+ * gets to skip up to the needle's length at a time. For shorter ones, where
+ * Horspool can't skip far, we instead compare the first and last grapheme of
+ * the needle against a whole vector's worth of positions at once, and only
+ * check the rest of the needle at the positions where both match.
+ *
+ * Horspool compares the whole needle wherever its last grapheme matches, so
+ * on repetitive text it can take time proportional to the product of the
+ * lengths. Should that happen, it hands over to two-way matching, which is
+ * slower in the usual case but linear in the worst. */
+
+/* Needles at least this long are searched for using Horspool. */
+#define HORSPOOL_MIN_NEEDLE 32
+
+/* Horspool gives up on a search once it has spent this many times as many
+ * graphemes on failed comparisons as it has moved through the haystack. */
+#define HORSPOOL_WASTE_FACTOR 8
+
+/* Two-way matching (Crochemore and Perrin), which needs no extra space. It
+ * returns the first match's position or -1. The GET used to read graphemes
+ * may count from the end of the haystack and needle rather than the start,
+ * which makes the first match found the last one in the real haystack. */
+#define GET_FORWARDS(s, len, i)  ((s)[i])
+#define GET_BACKWARDS(s, len, i) ((s)[(len) - 1 - (i)])
+#define MVM_TWO_WAY(name, type, GET) \
+static MVMint64 max_suffix_##name(const type *needle, MVMint64 m, \
+        MVMint32 reversed, MVMint64 *period) { \
+    MVMint64 ms = -1, j = 0, k = 1, p = 1; \
+    while (j + k < m) { \
+        type a = GET(needle, m, j + k); \
+        type b = GET(needle, m, ms + k); \
+        if (reversed ? a > b : a < b) { \
+            j += k; \
+            k  = 1; \
+            p  = j - ms; \
+        } \
+        else if (a == b) { \
+            if (k != p) { \
+                k++; \
+            } \
+            else { \
+                j += p; \
+                k  = 1; \
+            } \
+        } \
+        else { \
+            ms = j; \
+            j  = ms + 1; \
+            k  = p = 1; \
+        } \
+    } \
+    *period = p; \
+    return ms; \
+} \
+static MVMint64 two_way_##name(const type *haystack, MVMint64 n, \
+        const type *needle, MVMint64 m) { \
+    MVMint64 p, q, ell, period, i, j = 0; \
+    MVMint64 ms  = max_suffix_##name(needle, m, 0, &p); \
+    MVMint64 rms = max_suffix_##name(needle, m, 1, &q); \
+    if (ms > rms) { \
+        ell    = ms; \
+        period = p; \
+    } \
+    else { \
+        ell    = rms; \
+        period = q; \
+    } \
+    for (i = 0; i <= ell; i++) \
+        if (GET(needle, m, i) != GET(needle, m, i + period)) \
+            break; \
+    if (i > ell) { \
+        /* The needle is periodic, so after a shift by the period we know \
+         * how much of its left part already matches. */ \
+        MVMint64 memory = -1; \
+        while (j <= n - m) { \
+            i = (ell > memory ? ell : memory) + 1; \
+            while (i < m && GET(needle, m, i) == GET(haystack, n, i + j)) \
+                i++; \
+            if (i >= m) { \
+                i = ell; \
+                while (i > memory && GET(needle, m, i) == GET(haystack, n, i + j)) \
+                    i--; \
+                if (i <= memory) \
+                    return j; \
+                j     += period; \
+                memory = m - period - 1; \
+            } \
+            else { \
+                j     += i - ell; \
+                memory = -1; \
+            } \
+        } \
+    } \
+    else { \
+        period = (ell + 1 > m - ell - 1 ? ell + 1 : m - ell - 1) + 1; \
+        while (j <= n - m) { \
+            i = ell + 1; \
+            while (i < m && GET(needle, m, i) == GET(haystack, n, i + j)) \
+                i++; \
+            if (i >= m) { \
+                i = ell; \
+                while (i >= 0 && GET(needle, m, i) == GET(haystack, n, i + j)) \
+                    i--; \
+                if (i < 0) \
+                    return j; \
+                j += period; \
+            } \
+            else { \
+                j += i - ell; \
+            } \
+        } \
+    } \
+    return -1; \
+}
+
+MVM_TWO_WAY(8, MVMGrapheme8, GET_FORWARDS)
+MVM_TWO_WAY(32, MVMGrapheme32, GET_FORWARDS)
+MVM_TWO_WAY(last_8, MVMGrapheme8, GET_BACKWARDS)
+MVM_TWO_WAY(last_32, MVMGrapheme32, GET_BACKWARDS)
+
+/* Builds the Horspool shift table. 32-bit graphemes are looked up by their
+ * low byte, so a slot shared by several graphemes gets the smallest of their
+ * shifts; that only ever costs us some skipping. Going forwards, the shift
+ * is how far a grapheme is from the end of the needle; going backwards, how
+ * far it is from the start. */
+static void shifts_8(const MVMGrapheme8 *needle, size_t needle_length,
+        MVMint32 backwards, size_t *shifts) {
+    size_t i;
+    for (i = 0; i < 256; i++)
+        shifts[i] = needle_length;
+    if (backwards)
+        for (i = needle_length - 1; i > 0; i--)
+            shifts[(MVMuint8)needle[i]] = i;
+    else
+        for (i = 0; i < needle_length - 1; i++)
+            shifts[(MVMuint8)needle[i]] = needle_length - 1 - i;
+}
+static void shifts_32(const MVMGrapheme32 *needle, size_t needle_length,
+        MVMint32 backwards, size_t *shifts) {
+    size_t i;
+    for (i = 0; i < 256; i++)
+        shifts[i] = needle_length;
+    if (backwards)
+        for (i = needle_length - 1; i > 0; i--)
+            shifts[(MVMuint8)needle[i]] = i;
+    else
+        for (i = 0; i < needle_length - 1; i++)
+            shifts[(MVMuint8)needle[i]] = needle_length - 1 - i;
+}
+
+static MVMint64 horspool_8(const MVMGrapheme8 *haystack, size_t haystack_length,
+        const MVMGrapheme8 *needle, size_t needle_length, size_t pos) {
+    size_t shifts[256];
+    size_t last   = needle_length - 1;
+    size_t start  = pos;
+    size_t wasted = 0;
+    shifts_8(needle, needle_length, 0, shifts);
+    while (pos + needle_length <= haystack_length) {
+        MVMGrapheme8 g = haystack[pos + last];
+        if (g == needle[last]) {
+            if (memcmp(haystack + pos, needle, last) == 0)
+                return (MVMint64)pos;
+            wasted += needle_length;
+            if (wasted > HORSPOOL_WASTE_FACTOR * (pos - start + needle_length)) {
+                MVMint64 found = two_way_8(haystack + pos, haystack_length - pos,
+                    needle, needle_length);
+                return found < 0 ? -1 : (MVMint64)pos + found;
+            }
+        }
+        pos += shifts[(MVMuint8)g];
+    }
+    return -1;
+}
+static MVMint64 horspool_32(const MVMGrapheme32 *haystack, size_t haystack_length,
+        const MVMGrapheme32 *needle, size_t needle_length, size_t pos) {
+    size_t shifts[256];
+    size_t last   = needle_length - 1;
+    size_t start  = pos;
+    size_t wasted = 0;
+    shifts_32(needle, needle_length, 0, shifts);
+    while (pos + needle_length <= haystack_length) {
+        MVMGrapheme32 g = haystack[pos + last];
+        if (g == needle[last]) {
+            if (memcmp(haystack + pos, needle, last * sizeof(MVMGrapheme32)) == 0)
+                return (MVMint64)pos;
+            wasted += needle_length;
+            if (wasted > HORSPOOL_WASTE_FACTOR * (pos - start + needle_length)) {
+                MVMint64 found = two_way_32(haystack + pos, haystack_length - pos,
+                    needle, needle_length);
+                return found < 0 ? -1 : (MVMint64)pos + found;
+            }
+        }
+        pos += shifts[(MVMuint8)g];
+    }
+    return -1;
+}
+
+/* Versions of the first-and-last filter. Each returns the first match, or
+ * hands over to Horspool for the tail too short for a whole vector. */
+#if MVM_SCAN_SSE2
+static MVMint64 filter_8_sse2(const MVMGrapheme8 *haystack, size_t haystack_length,
+        const MVMGrapheme8 *needle, size_t needle_length) {
+    const __m128i first = _mm_set1_epi8(needle[0]);
+    const __m128i last  = _mm_set1_epi8(needle[needle_length - 1]);
+    size_t i = 0;
+    while (i + needle_length - 1 + 16 <= haystack_length) {
+        __m128i block_first = _mm_loadu_si128((const __m128i *)(haystack + i));
+        __m128i block_last  = _mm_loadu_si128((const __m128i *)(haystack + i + needle_length - 1));
+        MVMuint32 mask = (MVMuint32)_mm_movemask_epi8(_mm_and_si128(
+            _mm_cmpeq_epi8(block_first, first), _mm_cmpeq_epi8(block_last, last)));
+        while (mask) {
+            MVMuint32 bit = lowest_set_bit(mask);
+            if (memcmp(haystack + i + bit, needle, needle_length) == 0)
+                return (MVMint64)(i + bit);
+            mask &= mask - 1;
+        }
+        i += 16;
+    }
+    return horspool_8(haystack, haystack_length, needle, needle_length, i);
+}
+static MVMint64 filter_32_sse2(const MVMGrapheme32 *haystack, size_t haystack_length,
+        const MVMGrapheme32 *needle, size_t needle_length) {
+    const __m128i first = _mm_set1_epi32(needle[0]);
+    const __m128i last  = _mm_set1_epi32(needle[needle_length - 1]);
+    size_t i = 0;
+    while (i + needle_length - 1 + 4 <= haystack_length) {
+        __m128i block_first = _mm_loadu_si128((const __m128i *)(haystack + i));
+        __m128i block_last  = _mm_loadu_si128((const __m128i *)(haystack + i + needle_length - 1));
+        MVMuint32 mask = (MVMuint32)_mm_movemask_ps(_mm_castsi128_ps(_mm_and_si128(
+            _mm_cmpeq_epi32(block_first, first), _mm_cmpeq_epi32(block_last, last))));
+        while (mask) {
+            MVMuint32 bit = lowest_set_bit(mask);
+            if (memcmp(haystack + i + bit, needle, needle_length * sizeof(MVMGrapheme32)) == 0)
+                return (MVMint64)(i + bit);
+            mask &= mask - 1;
+        }
+        i += 4;
+    }
+    return horspool_32(haystack, haystack_length, needle, needle_length, i);
+}
+#endif
+
+#if MVM_SCAN_AVX2
+MVM_TARGET_AVX2
+static MVMint64 filter_8_avx2(const MVMGrapheme8 *haystack, size_t haystack_length,
+        const MVMGrapheme8 *needle, size_t needle_length) {
+    const __m256i first = _mm256_set1_epi8(needle[0]);
+    const __m256i last  = _mm256_set1_epi8(needle[needle_length - 1]);
+    size_t i = 0;
+    while (i + needle_length - 1 + 32 <= haystack_length) {
+        __m256i block_first = _mm256_loadu_si256((const __m256i *)(haystack + i));
+        __m256i block_last  = _mm256_loadu_si256((const __m256i *)(haystack + i + needle_length - 1));
+        MVMuint32 mask = (MVMuint32)_mm256_movemask_epi8(_mm256_and_si256(
+            _mm256_cmpeq_epi8(block_first, first), _mm256_cmpeq_epi8(block_last, last)));
+        while (mask) {
+            MVMuint32 bit = lowest_set_bit(mask);
+            if (memcmp(haystack + i + bit, needle, needle_length) == 0)
+                return (MVMint64)(i + bit);
+            mask &= mask - 1;
+        }
+        i += 32;
+    }
+    return horspool_8(haystack, haystack_length, needle, needle_length, i);
+}
+MVM_TARGET_AVX2
+static MVMint64 filter_32_avx2(const MVMGrapheme32 *haystack, size_t haystack_length,
+        const MVMGrapheme32 *needle, size_t needle_length) {
+    const __m256i first = _mm256_set1_epi32(needle[0]);
+    const __m256i last  = _mm256_set1_epi32(needle[needle_length - 1]);
+    size_t i = 0;
+    while (i + needle_length - 1 + 8 <= haystack_length) {
+        __m256i block_first = _mm256_loadu_si256((const __m256i *)(haystack + i));
+        __m256i block_last  = _mm256_loadu_si256((const __m256i *)(haystack + i + needle_length - 1));
+        MVMuint32 mask = (MVMuint32)_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_and_si256(
+            _mm256_cmpeq_epi32(block_first, first), _mm256_cmpeq_epi32(block_last, last))));
+        while (mask) {
+            MVMuint32 bit = lowest_set_bit(mask);
+            if (memcmp(haystack + i + bit, needle, needle_length * sizeof(MVMGrapheme32)) == 0)
+                return (MVMint64)(i + bit);
+            mask &= mask - 1;
+        }
+        i += 8;
+    }
+    return horspool_32(haystack, haystack_length, needle, needle_length, i);
+}
+#endif
+
+/* Finds the first occurrence of the needle in the haystack, returning its
+ * position or -1 if there is none. The needle must not be empty. */
+MVMint64 MVM_string_search_8(const MVMGrapheme8 *haystack, size_t haystack_length,
+        const MVMGrapheme8 *needle, size_t needle_length) {
+    if (needle_length > haystack_length)
+        return -1;
+    if (needle_length < HORSPOOL_MIN_NEEDLE) {
+#if MVM_SCAN_AVX2
+        if (MVM_platform_cpu_features() & MVM_CPU_FEATURE_AVX2)
+            return filter_8_avx2(haystack, haystack_length, needle, needle_length);
+#endif
+#if MVM_SCAN_SSE2
+        if (MVM_platform_cpu_features() & MVM_CPU_FEATURE_SSE2)
+            return filter_8_sse2(haystack, haystack_length, needle, needle_length);
+#endif
+    }
+    return horspool_8(haystack, haystack_length, needle, needle_length, 0);
+}
+MVMint64 MVM_string_search_32(const MVMGrapheme32 *haystack, size_t haystack_length,
+        const MVMGrapheme32 *needle, size_t needle_length) {
+    if (needle_length > haystack_length)
+        return -1;
+    if (needle_length < HORSPOOL_MIN_NEEDLE) {
+#if MVM_SCAN_AVX2
+        if (MVM_platform_cpu_features() & MVM_CPU_FEATURE_AVX2)
+            return filter_32_avx2(haystack, haystack_length, needle, needle_length);
+#endif
+#if MVM_SCAN_SSE2
+        if (MVM_platform_cpu_features() & MVM_CPU_FEATURE_SSE2)
+            return filter_32_sse2(haystack, haystack_length, needle, needle_length);
+#endif
+    }
+    return horspool_32(haystack, haystack_length, needle, needle_length, 0);
+}
+
+/* Finds the last occurrence of the needle in the haystack, using Horspool
+ * run backwards from the end, or two-way matching should that do too much
+ * work. The needle must not be empty. */
+MVMint64 MVM_string_search_last_8(const MVMGrapheme8 *haystack, size_t haystack_length,
+        const MVMGrapheme8 *needle, size_t needle_length) {
+    size_t shifts[256];
+    size_t pos, start;
+    size_t wasted = 0;
+    if (needle_length > haystack_length)
+        return -1;
+    shifts_8(needle, needle_length, 1, shifts);
+    pos = start = haystack_length - needle_length;
+    while (1) {
+        MVMGrapheme8 g = haystack[pos];
+        if (g == needle[0]) {
+            if (memcmp(haystack + pos + 1, needle + 1, needle_length - 1) == 0)
+                return (MVMint64)pos;
+            wasted += needle_length;
+            if (wasted > HORSPOOL_WASTE_FACTOR * (start - pos + needle_length)) {
+                MVMint64 found = two_way_last_8(haystack, pos + needle_length,
+                    needle, needle_length);
+                return found < 0 ? -1 : (MVMint64)(pos - found);
+            }
+        }
+        if (pos < shifts[(MVMuint8)g])
+            return -1;
+        pos -= shifts[(MVMuint8)g];
+    }
+}
+MVMint64 MVM_string_search_last_32(const MVMGrapheme32 *haystack, size_t haystack_length,
+        const MVMGrapheme32 *needle, size_t needle_length) {
+    size_t shifts[256];
+    size_t pos, start;
+    size_t wasted = 0;
+    if (needle_length > haystack_length)
+        return -1;
+    shifts_32(needle, needle_length, 1, shifts);
+    pos = start = haystack_length - needle_length;
+    while (1) {
+        MVMGrapheme32 g = haystack[pos];
+        if (g == needle[0]) {
+            if (memcmp(haystack + pos + 1, needle + 1,
+                    (needle_length - 1) * sizeof(MVMGrapheme32)) == 0)
+                return (MVMint64)pos;
+            wasted += needle_length;
+            if (wasted > HORSPOOL_WASTE_FACTOR * (start - pos + needle_length)) {
+                MVMint64 found = two_way_last_32(haystack, pos + needle_length,
+                    needle, needle_length);
+                return found < 0 ? -1 : (MVMint64)(pos - found);
+            }
+        }
+        if (pos < shifts[(MVMuint8)g])
+            return -1;
+        pos -= shifts[(MVMuint8)g];
+    }
+}
+
+/* Finding a single grapheme, as when splitting on a one-grapheme separator.
+ * For 8-bit graphemes the C library's memchr is already vectorised; for the
+ * 32-bit case we compare a vector's worth at a time ourselves. */
+static MVMint64 find_grapheme_32_scalar(const MVMGrapheme32 *haystack, size_t length,
+        MVMGrapheme32 g, size_t i) {
+    for (; i < length; i++)
+        if (haystack[i] == g)
+            return (MVMint64)i;
+    return -1;
+}
+#if MVM_SCAN_SSE2
+static MVMint64 find_grapheme_32_sse2(const MVMGrapheme32 *haystack, size_t length,
+        MVMGrapheme32 g) {
+    const __m128i want = _mm_set1_epi32(g);
+    size_t i = 0;
+    while (i + 8 <= length) {
+        __m128i a = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *)(haystack + i)), want);
+        __m128i b = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *)(haystack + i + 4)), want);
+        MVMuint32 mask = (MVMuint32)_mm_movemask_ps(_mm_castsi128_ps(a))
+            | ((MVMuint32)_mm_movemask_ps(_mm_castsi128_ps(b)) << 4);
+        if (mask)
+            return (MVMint64)(i + lowest_set_bit(mask));
+        i += 8;
+    }
+    return find_grapheme_32_scalar(haystack, length, g, i);
+}
+#endif
+#if MVM_SCAN_AVX2
+MVM_TARGET_AVX2
+static MVMint64 find_grapheme_32_avx2(const MVMGrapheme32 *haystack, size_t length,
+        MVMGrapheme32 g) {
+    const __m256i want = _mm256_set1_epi32(g);
+    size_t i = 0;
+    while (i + 16 <= length) {
+        __m256i a = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *)(haystack + i)), want);
+        __m256i b = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *)(haystack + i + 8)), want);
+        MVMuint32 mask = (MVMuint32)_mm256_movemask_ps(_mm256_castsi256_ps(a))
+            | ((MVMuint32)_mm256_movemask_ps(_mm256_castsi256_ps(b)) << 8);
+        if (mask)
+            return (MVMint64)(i + lowest_set_bit(mask));
+        i += 16;
+    }
+    return find_grapheme_32_scalar(haystack, length, g, i);
+}
+#endif
+
+/* Finds the first occurrence of a single grapheme, returning its position or
+ * -1 if there is none. */
+MVMint64 MVM_string_find_grapheme_8(const MVMGrapheme8 *haystack, size_t length,
+        MVMGrapheme8 g) {
+    const MVMGrapheme8 *found = memchr(haystack, g, length);
+    return found ? (MVMint64)(found - haystack) : -1;
+}
+MVMint64 MVM_string_find_grapheme_32(const MVMGrapheme32 *haystack, size_t length,
+        MVMGrapheme32 g) {
+#if MVM_SCAN_AVX2
+    if (MVM_platform_cpu_features() & MVM_CPU_FEATURE_AVX2)
+        return find_grapheme_32_avx2(haystack, length, g);
+#endif
+#if MVM_SCAN_SSE2
+    if (MVM_platform_cpu_features() & MVM_CPU_FEATURE_SSE2)
+        return find_grapheme_32_sse2(haystack, length, g);
+#endif
+    return find_grapheme_32_scalar(haystack, length, g, 0);
+}
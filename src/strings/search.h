@@ -0,0 +1,15 @@
+/* Substring search over flat arrays of graphemes of the same width. */
+MVMint64 MVM_string_search_8(const MVMGrapheme8 *haystack, size_t haystack_length,
+    const MVMGrapheme8 *needle, size_t needle_length);
+MVMint64 MVM_string_search_32(const MVMGrapheme32 *haystack, size_t haystack_length,
+    const MVMGrapheme32 *needle, size_t needle_length);
+MVMint64 MVM_string_search_last_8(const MVMGrapheme8 *haystack, size_t haystack_length,
+    const MVMGrapheme8 *needle, size_t needle_length);
+MVMint64 MVM_string_search_last_32(const MVMGrapheme32 *haystack, size_t haystack_length,
+    const MVMGrapheme32 *needle, size_t needle_length);
+
+/* Finding a single grapheme in a flat array of graphemes. */
+MVMint64 MVM_string_find_grapheme_8(const MVMGrapheme8 *haystack, size_t length,
+    MVMGrapheme8 g);
+MVMint64 MVM_string_find_grapheme_32(const MVMGrapheme32 *haystack, size_t length,
+    MVMGrapheme32 g);
@@ -0,0 +1,28 @@
+/* Works out which SIMD instruction sets we can compile code for, for the
+ * string scanning and searching routines. Code using AVX2 must be marked
+ * with MVM_TARGET_AVX2 and only called if the CPU is found to support it. */
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MVM_SCAN_SSE2 1
+#include <emmintrin.h>
+#if defined(__GNUC__) || defined(__clang__)
+#define MVM_SCAN_AVX2 1
+#define MVM_TARGET_AVX2 __attribute__((target("avx2")))
+#include <immintrin.h>
+#elif defined(_MSC_VER)
+#define MVM_SCAN_AVX2 1
+#define MVM_TARGET_AVX2
+#include <immintrin.h>
+#endif
+#endif
+
+/* Index of the lowest set bit of a non-zero mask. */
+MVM_STATIC_INLINE MVMuint32 lowest_set_bit(MVMuint32 mask) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return (MVMuint32)index;
+#else
+    return (MVMuint32)__builtin_ctz(mask);
+#endif
+}
@@ -193,6 +193,111 @@ MVMint64 MVM_unicode_string_compare
     MVM_exception_throw_adhoc(tc, "unicmp_s end of function should not be reachable\n");
 }
 
+/* Sums the collation weights of a grapheme's codepoints at each level, as
+ * MVM_unicode_string_compare does. */
+static void grapheme_collation_weights(MVMThreadContext *tc, MVMGrapheme32 g, MVMuint32 weights[3]) {
+    MVMuint32 rev[3] = {0,0,0};
+    weights[0] = weights[1] = weights[2] = 0;
+    if (g < 0) {
+        MVMNFGSynthetic *synth = MVM_nfg_get_synthetic_info(tc, g);
+        MVMint32 i;
+        collation_adjust(tc, weights, rev, (1 + 4 + 16), synth->base);
+        for (i = 0; i < synth->num_combs; i++)
+            collation_adjust(tc, weights, rev, (1 + 4 + 16), synth->combs[i]);
+    }
+    else {
+        collation_adjust(tc, weights, rev, (1 + 4 + 16), g);
+    }
+}
+
+static MVMuint8 * put_key_uint32(MVMuint8 *out, MVMuint32 value) {
+    out[0] = (MVMuint8)(value >> 24);
+    out[1] = (MVMuint8)(value >> 16);
+    out[2] = (MVMuint8)(value >> 8);
+    out[3] = (MVMuint8)value;
+    return out + 4;
+}
+
+/* Computes a sort key for a string under the collation options taken by
+ * MVM_unicode_string_compare, and places it into the buffer, which must be
+ * an empty native array of 8-bit integers. Comparing two keys bytewise, as
+ * memcmp does, orders the strings the same way as comparing the strings
+ * themselves, so a sort can compute keys once per string. The one exception
+ * is where MVM_unicode_string_compare considers a string equal to a longer
+ * one that it is a prefix of (no quaternary level, or both directions of
+ * it); there, the shorter key sorts first.
+ *
+ * Each grapheme contributes a marker byte of 1, then a big-endian 32-bit
+ * weight for each enabled collation level (complemented if the level is
+ * reversed), then the grapheme itself if the quaternary level is enabled.
+ * A final byte of 0 or 2 makes shorter or longer strings sort first. The
+ * exception is the empty string, which MVM_unicode_string_compare always
+ * puts first, even when longer strings otherwise sort first; its key is
+ * just a 0 byte. */
+MVMObject * MVM_unicode_string_collation_key(MVMThreadContext *tc, MVMString *s,
+        MVMint64 collation_mode, MVMint64 lang_mode, MVMint64 country_mode, MVMObject *buf) {
+    MVMArrayREPRData *buf_rd;
+    MVMGraphemeIter gi;
+    MVMStringIndex graphs;
+    MVMuint8 *key, *out;
+    size_t bytes_per_graph;
+    MVMint32 levels[3];
+    MVMint32 i;
+
+    MVM_string_check_arg(tc, s, "collation key");
+    if (!IS_CONCRETE(buf) || REPR(buf)->ID != MVM_REPR_ID_VMArray)
+        MVM_exception_throw_adhoc(tc, "collation key requires a native array to write into");
+    buf_rd = (MVMArrayREPRData *)STABLE(buf)->REPR_data;
+    if (!buf_rd || (buf_rd->slot_type != MVM_ARRAY_U8 && buf_rd->slot_type != MVM_ARRAY_I8))
+        MVM_exception_throw_adhoc(tc, "collation key requires a native 8-bit int array");
+    if (((MVMArray *)buf)->body.slots.any)
+        MVM_exception_throw_adhoc(tc, "collation key requires an empty array");
+
+    /* For each level, 1 to sort by weight, -1 to sort by reversed weight,
+     * or 0 if it plays no part (a level both forward and reversed cancels
+     * itself out in comparisons). */
+    bytes_per_graph = 1;
+    for (i = 0; i < 3; i++) {
+        MVMint64 forward  = collation_mode & (1 << (2 * i));
+        MVMint64 reversed = collation_mode & (2 << (2 * i));
+        levels[i] = forward && !reversed ? 1 : reversed && !forward ? -1 : 0;
+        if (levels[i])
+            bytes_per_graph += 4;
+    }
+    if (collation_mode & (64 + 128))
+        bytes_per_graph += 4;
+
+    graphs = MVM_string_graphs_nocheck(tc, s);
+    key    = MVM_malloc(graphs * bytes_per_graph + 1);
+    out    = key;
+    MVM_string_gi_init(tc, &gi, s);
+    while (MVM_string_gi_has_more(tc, &gi)) {
+        MVMGrapheme32 g = MVM_string_gi_get_grapheme(tc, &gi);
+        MVMuint32 weights[3];
+        grapheme_collation_weights(tc, g, weights);
+        *out++ = 1;
+        for (i = 0; i < 3; i++) {
+            if (levels[i] == 1)
+                out = put_key_uint32(out, weights[i]);
+            else if (levels[i] == -1)
+                out = put_key_uint32(out, ~weights[i]);
+        }
+        /* Graphemes compare as signed values; flipping the sign bit makes
+         * them compare the same way unsigned. */
+        if (collation_mode & 64)
+            out = put_key_uint32(out, (MVMuint32)g ^ 0x80000000);
+        else if (collation_mode & 128)
+            out = put_key_uint32(out, ~((MVMuint32)g ^ 0x80000000));
+    }
+    *out++ = graphs && (collation_mode & 128) && !(collation_mode & 64) ? 2 : 0;
+
+    ((MVMArray *)buf)->body.slots.u8 = key;
+    ((MVMArray *)buf)->body.start    = 0;
+    ((MVMArray *)buf)->body.ssize    = out - key;
+    ((MVMArray *)buf)->body.elems    = out - key;
+    return buf;
+}
+
 /* Looks up a codepoint by name. Lazily constructs a hash. */
 MVMGrapheme32 MVM_unicode_lookup_by_name(MVMThreadContext *tc, MVMString *name) {
     MVMuint64 size;
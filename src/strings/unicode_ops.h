@@ -1,4 +1,6 @@
 MVMint64 MVM_unicode_string_compare(MVMThreadContext *tc, MVMString *a, MVMString *b,
     MVMint64 collation_mode, MVMint64 lang_mode, MVMint64 country_mode);
+MVMObject * MVM_unicode_string_collation_key(MVMThreadContext *tc, MVMString *s,
+    MVMint64 collation_mode, MVMint64 lang_mode, MVMint64 country_mode, MVMObject *buf);
 
 MVMString * MVM_unicode_string_from_name(MVMThreadContext *tc, MVMString *name);
@@ -10,7 +10,10 @@
 MVMString * MVM_string_utf16_decode(MVMThreadContext *tc,
         const MVMObject *result_type, char *utf16_chars, size_t bytes) {
     MVMString *result = (MVMString *)REPR(result_type)->allocate(tc, STABLE(result_type));
-    size_t str_pos = 0;
+    MVMint64 str_pos = 0;
+    MVMint64 str_alloc;
+    MVMCodepoint chunk[64];
+    MVMint32 chunk_pos = 0;
     MVMuint8 *utf16 = (MVMuint8 *)utf16_chars;
     MVMuint8 *utf16_end;
     /* set the default byte order */
@@ -46,7 +49,8 @@ MVMString * MVM_string_utf16_decode(MVMThreadContext *tc,
     utf16_end = utf16 + bytes;
 
     /* possibly allocating extra space; oh well */
-    result->body.storage.blob_32 = MVM_malloc(sizeof(MVMGrapheme32) * bytes / 2);
+    str_alloc = bytes / 2 + 1;
+    result->body.storage.blob_32 = MVM_malloc(sizeof(MVMGrapheme32) * str_alloc);
 
     /* Need to normalize to NFG as we decode. */
     MVM_unicode_normalizer_init(tc, &norm, MVM_NORMALIZE_NFG);
@@ -54,7 +58,6 @@ MVMString * MVM_string_utf16_decode(MVMThreadContext *tc,
     for (; utf16 < utf16_end; utf16 += 2) {
         MVMuint32 value = (utf16[high] << 8) + utf16[low];
         MVMuint32 value2;
-        MVMGrapheme32 g;
 
         if ((value & 0xFC00) == 0xDC00) {
             MVM_unicode_normalizer_cleanup(tc, &norm);
@@ -76,23 +79,31 @@ MVMString * MVM_string_utf16_decode(MVMThreadContext *tc,
         }
 
         /* TODO: check for invalid values */
-        ready = MVM_unicode_normalizer_process_codepoint_to_grapheme(tc, &norm, value, &g);
-        if (ready) {
-            result->body.storage.blob_32[str_pos++] = g;
-            while (--ready > 0)
-                result->body.storage.blob_32[str_pos++] = MVM_unicode_normalizer_get_grapheme(tc, &norm);
+        /* Normalize in chunks, so runs of codepoints that need no
+         * normalization can be taken in bulk. */
+        chunk[chunk_pos++] = value;
+        if (chunk_pos == 64) {
+            MVM_unicode_normalizer_process_codepoints(tc, &norm, chunk, chunk_pos,
+                &(result->body.storage.blob_32), &str_alloc, &str_pos);
+            chunk_pos = 0;
         }
     }
+    MVM_unicode_normalizer_process_codepoints(tc, &norm, chunk, chunk_pos,
+        &(result->body.storage.blob_32), &str_alloc, &str_pos);
 
     /* Get any final graphemes from the normalizer, and clean it up. */
     MVM_unicode_normalizer_eof(tc, &norm);
     ready = MVM_unicode_normalizer_available(tc, &norm);
+    if (str_pos + ready > str_alloc)
+        result->body.storage.blob_32 = MVM_realloc(result->body.storage.blob_32,
+            sizeof(MVMGrapheme32) * (str_pos + ready));
     while (ready--)
         result->body.storage.blob_32[str_pos++] = MVM_unicode_normalizer_get_grapheme(tc, &norm);
     MVM_unicode_normalizer_cleanup(tc, &norm);
 
     result->body.storage_type = MVM_STRING_GRAPHEME_32;
     result->body.num_graphs   = str_pos;
+    MVM_string_narrow_storage(tc, result);
 
     return result;
 }
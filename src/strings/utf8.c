@@ -172,48 +172,82 @@ static MVMint32 utf8_encode(MVMuint8 *bp, MVMCodepoint cp) {
  * a result of the specified type. The type must have the MVMString REPR. */
 MVMString * MVM_string_utf8_decode(MVMThreadContext *tc, const MVMObject *result_type, const char *utf8, size_t bytes) {
     MVMString *result = (MVMString *)REPR(result_type)->allocate(tc, STABLE(result_type));
-    MVMint32 count = 0;
+    MVMint64 count = 0;
     MVMCodepoint codepoint;
     MVMint32 line_ending = 0;
     MVMint32 state = 0;
-    MVMint32 bufsize = bytes;
-    MVMGrapheme32 lowest_graph  =  0x7fffffff;
-    MVMGrapheme32 highest_graph = -0x7fffffff;
-    MVMGrapheme32 *buffer = MVM_malloc(sizeof(MVMGrapheme32) * bufsize);
+    MVMint64 bufsize = bytes;
+    MVMCodepoint chunk[64];
+    MVMint32 chunk_pos = 0;
+    MVMGrapheme32 *buffer;
     size_t orig_bytes;
     const char *orig_utf8;
     MVMint32 line;
     MVMint32 col;
     MVMint32 ready;
-
-    /* Need to normalize to NFG as we decode. */
     MVMNormalizer norm;
-    MVM_unicode_normalizer_init(tc, &norm, MVM_NORMALIZE_NFG);
 
+    /* ASCII other than \r is already NFG, so if that's all we have then we
+     * can copy it straight into an 8-bit string. */
+    size_t ascii_prefix = MVM_string_scan_ascii((const MVMuint8 *)utf8, bytes);
+    if (ascii_prefix == bytes) {
+        result->body.storage.blob_8 = MVM_malloc(bytes);
+        memcpy(result->body.storage.blob_8, utf8, bytes);
+        result->body.storage_type   = MVM_STRING_GRAPHEME_8;
+        result->body.num_graphs     = bytes;
+        return result;
+    }
+
+    /* Otherwise, need to normalize to NFG as we decode. */
+    MVM_unicode_normalizer_init(tc, &norm, MVM_NORMALIZE_NFG);
+    buffer = MVM_malloc(sizeof(MVMGrapheme32) * bufsize);
     orig_bytes = bytes;
     orig_utf8 = utf8;
 
+    /* We can still take all but the last of any ASCII prefix as it is; the
+     * last may combine with what follows. */
+    if (ascii_prefix > 1) {
+        for (; count < (MVMint64)ascii_prefix - 1; count++)
+            buffer[count] = (MVMuint8)utf8[count];
+        utf8  += count;
+        bytes -= count;
+    }
+
     for (; bytes; ++utf8, --bytes) {
         switch(decode_utf8_byte(&state, &codepoint, (MVMuint8)*utf8)) {
         case UTF8_ACCEPT: { /* got a codepoint */
-            MVMGrapheme32 g;
-            ready = MVM_unicode_normalizer_process_codepoint_to_grapheme(tc, &norm, codepoint, &g);
-            if (ready) {
-                while (count + ready >= bufsize) { /* if the buffer's full make a bigger one */
-                    buffer = MVM_realloc(buffer, sizeof(MVMGrapheme32) * (
-                        bufsize >= UTF8_MAXINC ? (bufsize += UTF8_MAXINC) : (bufsize *= 2)
-                    ));
-                }
-                buffer[count++] = g;
-                lowest_graph = g < lowest_graph ? g : lowest_graph;
-                highest_graph = g > highest_graph ? g : highest_graph;
-                while (--ready > 0) {
-                    g = MVM_unicode_normalizer_get_grapheme(tc, &norm);
-                    lowest_graph = g < lowest_graph ? g : lowest_graph;
-                    highest_graph = g > highest_graph ? g : highest_graph;
-                    buffer[count++] = g;
+            /* Codepoints are normalized a chunk at a time, so that runs of
+             * them that normalization can't affect are taken in bulk. */
+            chunk[chunk_pos++] = codepoint;
+
+            /* If that was ASCII and more follows, the normalizer can take
+             * the run in one go, once it's seen everything before it. */
+            if (codepoint < 0x80 && bytes > 2 && (MVMuint8)utf8[1] < 0x80) {
+                MVMint32 run = (MVMint32)MVM_string_scan_ascii((const MVMuint8 *)utf8 + 1,
+                    bytes - 1 > 0x7FFFFFFF ? 0x7FFFFFFF : bytes - 1);
+                if (run > 1) {
+                    MVM_unicode_normalizer_process_codepoints(tc, &norm, chunk, chunk_pos,
+                        &buffer, &bufsize, &count);
+                    chunk_pos = 0;
+                    while (count + run >= bufsize) {
+                        buffer = MVM_realloc(buffer, sizeof(MVMGrapheme32) * (
+                            bufsize >= UTF8_MAXINC ? (bufsize += UTF8_MAXINC) : (bufsize *= 2)
+                        ));
+                    }
+                    ready = MVM_unicode_normalizer_process_ascii_run(tc, &norm,
+                        (const MVMuint8 *)utf8 + 1, run, buffer + count);
+                    if (ready >= 0) {
+                        count += ready;
+                        utf8  += run;
+                        bytes -= run;
+                    }
                 }
             }
+            if (chunk_pos == 64) {
+                MVM_unicode_normalizer_process_codepoints(tc, &norm, chunk, chunk_pos,
+                    &buffer, &bufsize, &count);
+                chunk_pos = 0;
+            }
             break;
         }
         case UTF8_REJECT:
@@ -257,6 +291,8 @@ MVMString * MVM_string_utf8_decode(MVMThreadContext *tc, const MVMObject *result
         MVM_free(buffer);
         MVM_exception_throw_adhoc(tc, "Malformed termination of UTF-8 string");
     }
+    MVM_unicode_normalizer_process_codepoints(tc, &norm, chunk, chunk_pos,
+        &buffer, &bufsize, &count);
 
     /* Get any final graphemes from the normalizer, and clean it up. */
     MVM_unicode_normalizer_eof(tc, &norm);
@@ -264,39 +300,23 @@ MVMString * MVM_string_utf8_decode(MVMThreadContext *tc, const MVMObject *result
     if (ready) {
         if (count + ready >= bufsize) {
             buffer = MVM_realloc(buffer, sizeof(MVMGrapheme32) * (count + ready));
+            bufsize = count + ready;
         }
-        while (ready--) {
-            MVMGrapheme32 g;
-            g = MVM_unicode_normalizer_get_grapheme(tc, &norm);
-            lowest_graph = g < lowest_graph ? g : lowest_graph;
-            highest_graph = g > highest_graph ? g : highest_graph;
-            buffer[count++] = g;
-        }
+        while (ready--)
+            buffer[count++] = MVM_unicode_normalizer_get_grapheme(tc, &norm);
     }
     MVM_unicode_normalizer_cleanup(tc, &norm);
 
-    /* If we're lucky, we can fit our string in 8 bits per grapheme.
-     * That happens when our lowest value is bigger than -129 and our
-     * highest value is lower than 128. */
-    if (lowest_graph >= -128 && highest_graph < 128) {
-        MVMGrapheme8 *new_buffer = MVM_malloc(sizeof(MVMGrapheme8) * count);
-        for (ready = 0; ready < count; ready++) {
-            new_buffer[ready] = buffer[ready];
-        }
-        MVM_free(buffer);
-        result->body.storage.blob_8  = new_buffer;
-        result->body.storage_type    = MVM_STRING_GRAPHEME_8;
-    } else {
-        /* just keep the same buffer as the MVMString's buffer.  Later
-         * we can add heuristics to resize it if we have enough free
-         * memory */
-        if (bufsize - count > 4) {
-            buffer = MVM_realloc(buffer, count * sizeof(MVMGrapheme32));
-        }
-        result->body.storage.blob_32 = buffer;
-        result->body.storage_type    = MVM_STRING_GRAPHEME_32;
+    /* Keep the same buffer as the MVMString's buffer, unless there's a lot
+     * of space to spare. If we're lucky, we can then fit our string in 8
+     * bits per grapheme. */
+    if (bufsize - count > 4) {
+        buffer = MVM_realloc(buffer, count * sizeof(MVMGrapheme32));
     }
+    result->body.storage.blob_32 = buffer;
+    result->body.storage_type    = MVM_STRING_GRAPHEME_32;
     result->body.num_graphs      = count;
+    MVM_string_narrow_storage(tc, result);
 
     return result;
 }
@@ -400,6 +420,34 @@ MVMuint32 MVM_string_utf8_decodestream(MVMThreadContext *tc, MVMDecodeStream *ds
             }
 
             while (pos < cur_bytes->length) {
+                /* Runs of ASCII other than \r need neither the DFA nor the
+                 * normalizer, so we hand them out directly. */
+                if (state == UTF8_ACCEPT && (MVMuint8)bytes[pos] < 0x80) {
+                    size_t run = MVM_string_scan_ascii((MVMuint8 *)bytes + pos,
+                        cur_bytes->length - pos);
+                    if (run) {
+                        while (run--) {
+                            if (count == bufsize) {
+                                MVM_string_decodestream_add_chars(tc, ds, buffer, bufsize);
+                                buffer = MVM_malloc(bufsize * sizeof(MVMGrapheme32));
+                                count = 0;
+                            }
+                            buffer[count++] = lag_codepoint;
+                            total++;
+                            if (MVM_string_decode_stream_maybe_sep(tc, seps, lag_codepoint) ||
+                                    stopper_chars && *stopper_chars == total) {
+                                reached_stopper = 1;
+                                last_accept_bytes = lag_last_accept_bytes;
+                                last_accept_pos = lag_last_accept_pos;
+                                goto done;
+                            }
+                            lag_codepoint = (MVMuint8)bytes[pos++];
+                            lag_last_accept_bytes = cur_bytes;
+                            lag_last_accept_pos = pos;
+                        }
+                        continue;
+                    }
+                }
                 switch(decode_utf8_byte(&state, &codepoint, bytes[pos++])) {
                 case UTF8_ACCEPT: {
                     /* If we hit something that needs the normalizer, we put
@@ -515,21 +563,172 @@ MVMuint32 MVM_string_utf8_decodestream(MVMThreadContext *tc, MVMDecodeStream *ds
     return reached_stopper;
 }
 
+/* Result codes from encoding a single grapheme. */
+#define ENCODE_NO_ROOM  -1
+#define ENCODE_BAD_CP   -2
+
+/* Encodes a codepoint into the space available, giving the number of bytes
+ * written or one of the codes above. */
+static MVMint64 encode_codepoint(MVMCodepoint cp, MVMuint8 *out, size_t room,
+        const MVMuint8 *repl_bytes, size_t repl_length, MVMCodepoint *bad_cp) {
+    MVMint32 bytes;
+    if (room >= 4) {
+        bytes = utf8_encode(out, cp);
+    }
+    else {
+        MVMuint8 tmp[4];
+        bytes = utf8_encode(tmp, cp);
+        if ((size_t)bytes > room)
+            return ENCODE_NO_ROOM;
+        memcpy(out, tmp, bytes);
+    }
+    if (bytes)
+        return bytes;
+    if (!repl_bytes) {
+        *bad_cp = cp;
+        return ENCODE_BAD_CP;
+    }
+    if (repl_length > room)
+        return ENCODE_NO_ROOM;
+    memcpy(out, repl_bytes, repl_length);
+    return repl_length;
+}
+
+/* Encodes a grapheme, which may be synthetic, into the space available. A
+ * grapheme is only ever written whole. */
+static MVMint64 encode_grapheme(MVMThreadContext *tc, MVMGrapheme32 g, MVMuint8 *out,
+        size_t room, const MVMuint8 *repl_bytes, size_t repl_length,
+        MVMint32 translate_newlines, MVMCodepoint *bad_cp) {
+    MVMNFGSynthetic *synth;
+    MVMint64 written, bytes;
+    MVMint32 i;
+#ifdef _WIN32
+    if (translate_newlines && g == '\n')
+        g = MVM_nfg_crlf_grapheme(tc);
+#endif
+    if (g >= 0)
+        return encode_codepoint(g, out, room, repl_bytes, repl_length, bad_cp);
+    synth   = MVM_nfg_get_synthetic_info(tc, g);
+    written = encode_codepoint(synth->base, out, room, repl_bytes, repl_length, bad_cp);
+    if (written < 0)
+        return written;
+    for (i = 0; i < synth->num_combs; i++) {
+        bytes = encode_codepoint(synth->combs[i], out + written, room - written,
+            repl_bytes, repl_length, bad_cp);
+        if (bytes < 0)
+            return bytes;
+        written += bytes;
+    }
+    return written;
+}
+
+/* Finds the flat string holding grapheme pos of s, along with the position
+ * in it and how many graphemes follow on from there in the same piece. */
+static MVMString * locate_piece(MVMThreadContext *tc, MVMString *s, MVMStringIndex pos,
+        MVMStringIndex *piece_pos, MVMStringIndex *piece_graphs) {
+    MVMuint16 i;
+    if (s->body.storage_type != MVM_STRING_STRAND) {
+        *piece_pos    = pos;
+        *piece_graphs = s->body.num_graphs - pos;
+        return s;
+    }
+    for (i = 0; i < s->body.num_strands; i++) {
+        MVMStringStrand *strand = &(s->body.storage.strands[i]);
+        MVMStringIndex   length = strand->end - strand->start;
+        MVMStringIndex   total  = length * (strand->repetitions + 1);
+        if (pos < total) {
+            *piece_pos    = strand->start + pos % length;
+            *piece_graphs = length - pos % length;
+            return strand->blob_string;
+        }
+        pos -= total;
+    }
+    MVM_exception_throw_adhoc(tc, "Internal error: string position out of range");
+}
+
+/* Encodes graphemes of the string from *pos up to end into the buffer, and
+ * stops early if the next grapheme would not fit. Runs of ASCII are copied
+ * or narrowed in bulk rather than going a grapheme at a time. Updates *pos
+ * and returns the number of bytes written. If a codepoint cannot be encoded
+ * and there is no replacement, it is put in *bad_cp and we stop there. */
+static size_t encode_range(MVMThreadContext *tc, MVMString *s, MVMStringIndex *pos,
+        MVMStringIndex end, MVMuint8 *out, size_t out_size,
+        const MVMuint8 *repl_bytes, size_t repl_length, MVMint32 translate_newlines,
+        MVMCodepoint *bad_cp) {
+    size_t written = 0;
+#ifdef _WIN32
+    MVMint32 bulk = !translate_newlines;
+#else
+    MVMint32 bulk = 1;
+#endif
+    while (*pos < end) {
+        MVMStringIndex piece_pos, piece_graphs, i, piece_end;
+        MVMString *piece = locate_piece(tc, s, *pos, &piece_pos, &piece_graphs);
+        if (piece_graphs > end - *pos)
+            piece_graphs = end - *pos;
+        i         = piece_pos;
+        piece_end = piece_pos + piece_graphs;
+        while (i < piece_end) {
+            MVMGrapheme32 g;
+            MVMint64 bytes;
+            if (bulk) {
+                size_t want = piece_end - i;
+                size_t run;
+                if (want > out_size - written)
+                    want = out_size - written;
+                switch (piece->body.storage_type) {
+                    case MVM_STRING_GRAPHEME_32:
+                        run = MVM_string_narrow_ascii(piece->body.storage.blob_32 + i,
+                            want, out + written);
+                        break;
+                    case MVM_STRING_GRAPHEME_ASCII:
+                    case MVM_STRING_GRAPHEME_8:
+                        run = MVM_string_scan_7bit(
+                            (const MVMuint8 *)piece->body.storage.blob_8 + i, want);
+                        memcpy(out + written, piece->body.storage.blob_8 + i, run);
+                        break;
+                    default:
+                        MVM_exception_throw_adhoc(tc,
+                            "Internal error: unexpected storage type in UTF-8 encode");
+                }
+                i       += run;
+                written += run;
+                if (i == piece_end)
+                    break;
+            }
+            g = piece->body.storage_type == MVM_STRING_GRAPHEME_32
+                ? piece->body.storage.blob_32[i]
+                : piece->body.storage.blob_8[i];
+            bytes = encode_grapheme(tc, g, out + written, out_size - written,
+                repl_bytes, repl_length, translate_newlines, bad_cp);
+            if (bytes < 0) {
+                *pos += i - piece_pos;
+                return written;
+            }
+            written += bytes;
+            i++;
+        }
+        *pos += piece_graphs;
+    }
+    return written;
+}
+
 /* Encodes the specified string to UTF-8. */
 char * MVM_string_utf8_encode_substr(MVMThreadContext *tc,
         MVMString *str, MVMuint64 *output_size, MVMint64 start, MVMint64 length,
         MVMString *replacement, MVMint32 translate_newlines) {
     MVMuint8        *result;
     size_t           result_pos, result_limit;
-    MVMCodepointIter ci;
     MVMStringIndex   strgraphs = MVM_string_graphs(tc, str);
+    MVMStringIndex   pos, end;
     MVMuint8        *repl_bytes = NULL;
-    MVMuint64        repl_length;
+    MVMuint64        repl_length = 0;
+    MVMCodepoint     bad_cp = -1;
 
     if (start < 0 || start > strgraphs)
         MVM_exception_throw_adhoc(tc, "start out of range");
     if (length == -1)
-        length = strgraphs;
+        length = strgraphs - start;
     if (length < 0 || start + length > strgraphs)
         MVM_exception_throw_adhoc(tc, "length out of range");
 
@@ -537,37 +736,26 @@ char * MVM_string_utf8_encode_substr(MVMThreadContext *tc,
         repl_bytes = (MVMuint8 *) MVM_string_utf8_encode_substr(tc,
             replacement, &repl_length, 0, -1, NULL, translate_newlines);
 
-    /* Guesstimate that we'll be within 2 bytes for most chars most of the
-     * time, and give ourselves 4 bytes breathing space. */
-    result_limit = 2 * length;
-    result       = MVM_malloc(result_limit + 4);
+    /* Start out with enough space for the all-ASCII case, plus a little
+     * breathing space, and grow as needed. */
+    result_limit = length + 4;
+    result       = MVM_malloc(result_limit);
     result_pos   = 0;
-
-    /* Iterate the codepoints and encode them. */
-    MVM_string_ci_init(tc, &ci, str, translate_newlines);
-    while (MVM_string_ci_has_more(tc, &ci)) {
-        MVMint32 bytes;
-        MVMCodepoint cp = MVM_string_ci_get_codepoint(tc, &ci);
-        if (result_pos >= result_limit) {
-            result_limit *= 2;
-            result = MVM_realloc(result, result_limit + 4);
-        }
-        bytes = utf8_encode(result + result_pos, cp);
-        if (bytes)
-            result_pos += bytes;
-        else if (replacement) {
-            if (repl_length >= result_limit || result_pos >= result_limit - repl_length) {
-                result_limit += repl_length;
-                result = MVM_realloc(result, result_limit + 4);
-            }
-            memcpy(result + result_pos, repl_bytes, repl_length);
-            result_pos += repl_length;
-        }
-        else {
+    pos          = (MVMStringIndex)start;
+    end          = (MVMStringIndex)(start + length);
+    while (1) {
+        result_pos += encode_range(tc, str, &pos, end, result + result_pos,
+            result_limit - result_pos, repl_bytes, repl_length, translate_newlines,
+            &bad_cp);
+        if (bad_cp >= 0) {
             MVM_free(result);
             MVM_free(repl_bytes);
-            MVM_string_utf8_throw_encoding_exception(tc, cp);
+            MVM_string_utf8_throw_encoding_exception(tc, bad_cp);
         }
+        if (pos == end)
+            break;
+        result_limit *= 2;
+        result = MVM_realloc(result, result_limit);
     }
 
     if (output_size)
@@ -576,6 +764,66 @@ char * MVM_string_utf8_encode_substr(MVMThreadContext *tc,
     return (char *)result;
 }
 
+/* Encodes as much of the string as will fit into the supplied buffer, from
+ * the grapheme at *pos onwards, never splitting a grapheme. Updates *pos to
+ * the first grapheme not encoded, and returns the number of bytes written;
+ * this is zero only if the string is done or the next grapheme needs more
+ * space than the buffer has. */
+MVMuint64 MVM_string_utf8_encode_into(MVMThreadContext *tc, MVMString *str,
+        MVMStringIndex *pos, char *buffer, MVMuint64 buffer_size,
+        MVMint32 translate_newlines) {
+    MVMCodepoint bad_cp  = -1;
+    size_t       written = encode_range(tc, str, pos, MVM_string_graphs(tc, str),
+        (MVMuint8 *)buffer, buffer_size, NULL, 0, translate_newlines, &bad_cp);
+    if (bad_cp >= 0)
+        MVM_string_utf8_throw_encoding_exception(tc, bad_cp);
+    return written;
+}
+
+/* Checks that everything in a range of a flat string can be encoded, and
+ * throws the exception encoding would if not. Latin-1 always can be, so
+ * only 32-bit storage needs looking at. */
+static void check_encodable_range(MVMThreadContext *tc, MVMString *s, MVMStringIndex start,
+        MVMStringIndex end) {
+    MVMStringIndex i;
+    if (s->body.storage_type != MVM_STRING_GRAPHEME_32)
+        return;
+    for (i = start; i < end; i++) {
+        MVMGrapheme32 g = s->body.storage.blob_32[i];
+        if (g >= 0) {
+            if (!(classify(g) & (CP_CHAR | CP_NONCHAR)))
+                MVM_string_utf8_throw_encoding_exception(tc, g);
+        }
+        else {
+            MVMNFGSynthetic *synth = MVM_nfg_get_synthetic_info(tc, g);
+            MVMint32 j;
+            if (!(classify(synth->base) & (CP_CHAR | CP_NONCHAR)))
+                MVM_string_utf8_throw_encoding_exception(tc, synth->base);
+            for (j = 0; j < synth->num_combs; j++)
+                if (!(classify(synth->combs[j]) & (CP_CHAR | CP_NONCHAR)))
+                    MVM_string_utf8_throw_encoding_exception(tc, synth->combs[j]);
+        }
+    }
+}
+
+/* Throws the exception that encoding the string to UTF-8 would, if it holds
+ * anything that cannot be encoded. Used by code that writes out each part of
+ * a string as soon as it is encoded, so that it never writes part of a
+ * string and then fails. */
+void MVM_string_utf8_check_encodable(MVMThreadContext *tc, MVMString *str) {
+    MVM_string_check_arg(tc, str, "encode");
+    if (str->body.storage_type == MVM_STRING_STRAND) {
+        MVMuint16 i;
+        for (i = 0; i < str->body.num_strands; i++) {
+            MVMStringStrand *strand = &(str->body.storage.strands[i]);
+            check_encodable_range(tc, strand->blob_string, strand->start, strand->end);
+        }
+    }
+    else {
+        check_encodable_range(tc, str, 0, str->body.num_graphs);
+    }
+}
+
 /* Encodes the specified string to UTF-8. */
 char * MVM_string_utf8_encode(MVMThreadContext *tc, MVMString *str, MVMuint64 *output_size,
         MVMint32 translate_newlines) {
@@ -242,6 +242,7 @@ MVMString * MVM_string_windows1252_decode(MVMThreadContext *tc,
         }
     }
     result->body.num_graphs = result_graphs;
+    MVM_string_narrow_storage(tc, result);
 
     return result;
 }
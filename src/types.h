@@ -12,6 +12,7 @@ typedef struct MVMAsyncTaskOps MVMAsyncTaskOps;
 typedef struct MVMAttributeIdentifier MVMAttributeIdentifier;
 typedef struct MVMBoolificationSpec MVMBoolificationSpec;
 typedef struct MVMBootTypes MVMBootTypes;
+typedef struct MVMByteSet MVMByteSet;
 typedef struct MVMBytecodeAnnotation MVMBytecodeAnnotation;
 typedef struct MVMCallCapture MVMCallCapture;
 typedef struct MVMCallCaptureBody MVMCallCaptureBody;
@@ -64,6 +65,7 @@ typedef struct MVMHashBody MVMHashBody;
 typedef struct MVMHashEntry MVMHashEntry;
 typedef struct MVMHLLConfig MVMHLLConfig;
 typedef struct MVMIntConstCache MVMIntConstCache;
+typedef struct MVMIntConstCacheRange MVMIntConstCacheRange;
 typedef struct MVMInstance MVMInstance;
 typedef struct MVMInvocationSpec MVMInvocationSpec;
 typedef struct MVMIter MVMIter;
@@ -124,8 +126,17 @@ typedef struct MVMSemaphore MVMSemaphore;
 typedef struct MVMSemaphoreBody MVMSemaphoreBody;
 typedef struct MVMConcBlockingQueue MVMConcBlockingQueue;
 typedef struct MVMConcBlockingQueueBody MVMConcBlockingQueueBody;
-typedef struct MVMConcBlockingQueueNode MVMConcBlockingQueueNode;
+typedef struct MVMConcBlockingQueueSegment MVMConcBlockingQueueSegment;
 typedef struct MVMConcBlockingQueueLocks MVMConcBlockingQueueLocks;
+typedef struct MVMConcArray MVMConcArray;
+typedef struct MVMConcArrayBody MVMConcArrayBody;
+typedef struct MVMConcArraySlots MVMConcArraySlots;
+typedef struct MVMConcHash MVMConcHash;
+typedef struct MVMConcHashBody MVMConcHashBody;
+typedef struct MVMConcHashBucket MVMConcHashBucket;
+typedef struct MVMConcHashEntry MVMConcHashEntry;
+typedef struct MVMConcHashLocks MVMConcHashLocks;
+typedef struct MVMConcHashTable MVMConcHashTable;
 typedef struct MVMObject MVMObject;
 typedef struct MVMObjectId MVMObjectId;
 typedef struct MVMObjectStooge MVMObjectStooge;
@@ -201,6 +212,11 @@ typedef struct MVMStaticFrameSpeshBody MVMStaticFrameSpeshBody;
 typedef struct MVMStorageSpec MVMStorageSpec;
 typedef struct MVMString MVMString;
 typedef struct MVMStringBody MVMStringBody;
+typedef struct MVMStringBuilder MVMStringBuilder;
+typedef struct MVMStringBuilderBody MVMStringBuilderBody;
+typedef struct MVMStringBuilderChunk MVMStringBuilderChunk;
+typedef struct MVMStringInternEntry MVMStringInternEntry;
+typedef struct MVMStringInternStripe MVMStringInternStripe;
 typedef struct MVMStringConsts MVMStringConsts;
 typedef struct MVMStringStrand MVMStringStrand;
 typedef struct MVMGraphemeIter MVMGraphemeIter;
@@ -54,6 +54,7 @@ my $gap_length_threshold = 1000;
 my $span_length_threshold = 100;
 my $skip_most_mode = 0;
 my $bitfield_cell_bitwidth = 32;
+my $codepoint_block_bits = 7;
 my %is_subtype = (
     Digit => {
         of => 'Numeric_Type',
@@ -136,6 +137,7 @@ sub main {
     progress("...done.\nemitting unicode_db.c...");
     emit_bitfield($first_point);
     $extents = emit_codepoints_and_planes($first_point);
+    emit_codepoint_bitfield_blocks($first_point);
     emit_case_changes($first_point);
     emit_codepoint_row_lookup($extents);
     emit_property_value_lookup($allocated_properties);
@@ -620,6 +622,47 @@ sub emit_codepoints_and_planes {
     $extents
 }
 
+sub emit_codepoint_bitfield_blocks {
+    # Two-stage lookup of the bitfield row for a codepoint, used for property
+    # lookups so they need neither the binary search over extents nor the
+    # extra indirection through the codepoint rows. The high bits of the
+    # codepoint select a block of bitfield indexes, and the low bits one of
+    # the indexes in it. Most blocks are unassigned or otherwise uniform, so
+    # identical blocks are shared.
+    my $point = shift;
+    my $block_size = 1 << $codepoint_block_bits;
+    my @rows = (0) x 0x110000;
+    while ($point) {
+        $rows[$point->{code}] = $point->{bitfield_index} if $point->{code} < 0x110000;
+        $point = $point->{next_point};
+    }
+    my %seen_blocks;
+    my @block_lines;
+    my @row_lines;
+    my $num_blocks = 0;
+    for (my $start = 0; $start < 0x110000; $start += $block_size) {
+        my @block = @rows[$start .. $start + $block_size - 1];
+        my $key = join ',', @block;
+        unless (exists $seen_blocks{$key}) {
+            $seen_blocks{$key} = $num_blocks++;
+            $block[0] = "/*".sprintf('%X', $start)."*/$block[0]";
+            push @row_lines, @block;
+        }
+        push @block_lines, $seen_blocks{$key};
+    }
+    my $bytes = 2 * (@block_lines + @row_lines);
+    print "\nUsing ".thousands($bytes)." bytes for $num_blocks distinct blocks of codepoint bitfield indexes.\n";
+    $estimated_total_bytes += $bytes;
+    $db_sections->{BBB_codepoint_bitfield_blocks} =
+        "#define MVM_CODEPOINT_BLOCK_BITS $codepoint_block_bits\n".
+        "static const MVMuint16 codepoint_bitfield_blocks[".scalar(@block_lines)."] = {\n    ".
+            stack_lines(\@block_lines, ",", ",\n    ", 0, $wrap_to_columns).
+            "\n};\n".
+        "static const MVMuint16 codepoint_bitfield_block_rows[".scalar(@row_lines)."] = {\n    ".
+            stack_lines(\@row_lines, ",", ",\n    ", 0, $wrap_to_columns).
+            "\n};";
+}
+
 sub emit_codepoint_row_lookup {
     my $extents = shift;
     my $SMP_start;
@@ -726,13 +769,17 @@ sub emit_property_value_lookup {
     my $out = "
 static MVMint32 MVM_unicode_get_property_int(MVMThreadContext *tc, MVMint64 codepoint, MVMint64 property_code) {
     MVMuint32 switch_val = (MVMuint32)property_code;
-    MVMuint32 codepoint_row = MVM_codepoint_to_row_index(tc, codepoint);
     MVMuint16 bitfield_row;
 
-    if (codepoint_row == -1) /* non-existent codepoint; XXX should throw? */
+    if (codepoint < 0) {
+        MVM_exception_throw_adhoc(tc, \"Error, MoarVM cannot get Unicode codepoint property for synthetic codepoint \%\"PRId64\"\", codepoint);
+    }
+    if (codepoint > 0x10FFFF) /* non-existent codepoint; XXX should throw? */
         return 0;
 
-    bitfield_row = codepoint_bitfield_indexes[codepoint_row];
+    bitfield_row = codepoint_bitfield_block_rows[
+        ((MVMuint32)codepoint_bitfield_blocks[codepoint >> MVM_CODEPOINT_BLOCK_BITS] << MVM_CODEPOINT_BLOCK_BITS)
+        | (codepoint & ((1 << MVM_CODEPOINT_BLOCK_BITS) - 1))];
 
     switch (switch_val) {
         case 0: return 0;";